@@ -0,0 +1,19 @@
+#include "dansandu/jelly/arena.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <memory_resource>
+#include <new>
+#include <string_view>
+
+using dansandu::jelly::json::pmr::Json;
+
+namespace dansandu::jelly::arena
+{
+
+Json& Arena::deserialize(std::string_view json)
+{
+    auto document = Json::deserialize(json, &resource_);
+    return *new (resource_.allocate(sizeof(Json), alignof(Json))) Json{std::move(document)};
+}
+
+}
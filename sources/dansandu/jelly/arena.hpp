@@ -0,0 +1,37 @@
+#pragma once
+
+#include "dansandu/jelly/json.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+namespace dansandu::jelly::arena
+{
+
+// Monotonic arena that owns every node of the documents deserialized into it. Nodes are never freed one by one:
+// destroying the arena releases the memory of all its documents at once without walking them, so references to the
+// documents must not outlive the arena.
+class PRALINE_EXPORT Arena
+{
+public:
+    explicit Arena(std::size_t initialSize = 64 * 1024) : resource_{initialSize}
+    {
+    }
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    dansandu::jelly::json::pmr::Json& deserialize(std::string_view json);
+
+    std::pmr::polymorphic_allocator<char> getAllocator()
+    {
+        return &resource_;
+    }
+
+private:
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
+}
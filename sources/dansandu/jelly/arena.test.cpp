@@ -0,0 +1,47 @@
+#include "dansandu/jelly/arena.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+using dansandu::jelly::arena::Arena;
+using dansandu::jelly::error::JsonDeserializationError;
+
+namespace pmr = dansandu::jelly::json::pmr;
+
+TEST_CASE("Arena")
+{
+    const auto string = R"({"identifier":"f2c4deb09cc1558f2c4deb09cc1558","location":[50,10],)"
+                        R"("samples":{"CO":2,"O2":19},"timestamp":1597780427})";
+
+    SECTION("arena")
+    {
+        auto arena = Arena{};
+
+        const auto& json = arena.deserialize(string);
+
+        REQUIRE(json.serialize() == string);
+
+        REQUIRE(json["samples"]["O2"].get<int>() == 19);
+
+        REQUIRE_THROWS_AS(arena.deserialize("[1, 2"), JsonDeserializationError);
+    }
+
+    SECTION("no allocation outside the resource")
+    {
+        auto buffer = std::array<std::byte, 16 * 1024>{};
+        auto resource =
+            std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        auto json = pmr::Json::deserialize(string, &resource);
+
+        json["location"][0] = 30;
+        json["samples"].get<pmr::Json::object_type>().emplace("CO2", pmr::Json{0.5});
+
+        REQUIRE(json.serialize() == R"({"identifier":"f2c4deb09cc1558f2c4deb09cc1558","location":[30,10],)"
+                                    R"("samples":{"CO":2,"O2":19,"CO2":0.5},"timestamp":1597780427})");
+    }
+}
@@ -0,0 +1,481 @@
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/internal/scanner.hpp"
+#include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/json.hpp"
+#include "dansandu/jelly/parser.hpp"
+#include "dansandu/jelly/sax.hpp"
+#include "dansandu/jelly/view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using dansandu::jelly::internal::scanner::BlockClassifier;
+using dansandu::jelly::internal::scanner::getClassifier;
+using dansandu::jelly::internal::scanner::getScalarClassifier;
+using dansandu::jelly::internal::scanner::StructuralScanner;
+using dansandu::jelly::internal::tokenizer::Tokenizer;
+using dansandu::jelly::json::Json;
+using dansandu::jelly::parser::JsonParser;
+using dansandu::jelly::sax::Handler;
+using dansandu::jelly::view::Document;
+
+// The benchmarks are hidden test cases, so they only run when the [benchmark] tag is passed to the test executable.
+
+// Builds an array of orders that mixes every kind of value, with roughly 300 bytes per order.
+static std::string makeOrders(const int count)
+{
+    auto orders = std::string{"["};
+    for (auto i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            orders += ',';
+        }
+        orders += R"({"orderId":"471fc736-56e9-4a78-a256-)" + std::to_string(100000000000 + i) + R"(","items":[)";
+        for (auto j = 0; j < 3; ++j)
+        {
+            orders += j > 0 ? "," : "";
+            orders += R"({"itemId":")" + std::to_string(i * 3 + j) + R"(","count":)" + std::to_string(j + 1) +
+                      R"(,"price":)" + std::to_string(i % 100) + "." + std::to_string(j * 25) + "}";
+        }
+        orders += R"(],"hasPromotion":)" + std::string{i % 2 == 0 ? "true" : "false"} +
+                  R"(,"vat":0.20,"previousOrderId":null,"note":"line\nbreak"})";
+    }
+    orders += ']';
+    return orders;
+}
+
+// Builds an array of integers and doubles of varied lengths, signs and exponents.
+static std::string makeNumbers(const int count)
+{
+    auto numbers = std::string{"["};
+    for (auto i = 0; i < count; ++i)
+    {
+        numbers += i > 0 ? "," : "";
+        switch (i % 4)
+        {
+        case 0:
+            numbers += std::to_string(i * 7919);
+            break;
+        case 1:
+            numbers += std::to_string(-static_cast<long long>(i) * 2654435761);
+            break;
+        case 2:
+            numbers += std::to_string(i) + "." + std::to_string(i % 997);
+            break;
+        default:
+            numbers += std::to_string(i % 89) + ".5e-" + std::to_string(i % 300);
+        }
+    }
+    numbers += ']';
+    return numbers;
+}
+
+// Builds an array of people whose members are all strings, from a few bytes up to about a hundred, some with escapes.
+static std::string makeStrings(const int count)
+{
+    auto people = std::string{"["};
+    for (auto i = 0; i < count; ++i)
+    {
+        const auto number = std::to_string(i);
+        people += i > 0 ? "," : "";
+        people += R"({"id":")" + number + R"(","name":"Person )" + number + R"(","email":"person.)" + number +
+                  R"(@example.com","city":"Cluj-Napoca","country":"RO","bio":"Likes \"quoted\" words, tabs\tand )" +
+                  std::string(i % 64, 'x') + R"("})";
+    }
+    people += ']';
+    return people;
+}
+
+// Lays the JSON out on separate lines indented by four spaces per level, like a hand written or pretty printed file.
+static std::string indent(const std::string& json)
+{
+    auto indented = std::string{};
+    auto depth = 0;
+    auto inString = false;
+    const auto newLine = [&] { indented += '\n' + std::string(4 * depth, ' '); };
+    for (auto i = std::size_t{0}; i < json.size(); ++i)
+    {
+        const auto character = json[i];
+        if (inString)
+        {
+            indented += character;
+            if (character == '\\')
+            {
+                indented += json[++i];
+            }
+            inString = character != '"';
+            continue;
+        }
+        switch (character)
+        {
+        case '[':
+        case '{':
+            indented += character;
+            ++depth;
+            newLine();
+            break;
+        case ']':
+        case '}':
+            --depth;
+            newLine();
+            indented += character;
+            break;
+        case ',':
+            indented += character;
+            newLine();
+            break;
+        case ':':
+            indented += ": ";
+            break;
+        default:
+            indented += character;
+            inString = character == '"';
+        }
+    }
+    return indented;
+}
+
+// Forwards to the default resource and keeps count of the allocations and of the most bytes held at once.
+class MeasuringResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+    std::size_t peakBytes = 0;
+
+private:
+    void* do_allocate(std::size_t size, std::size_t alignment) override
+    {
+        ++allocations;
+        bytes += size;
+        peakBytes = std::max(peakBytes, bytes);
+        return std::pmr::get_default_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override
+    {
+        bytes -= size;
+        std::pmr::get_default_resource()->deallocate(pointer, size, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// Runs the function at least five times and for at least a tenth of a second, then prints the mean time of one run and
+// the throughput over the given number of bytes, if any. The results of the runs are summed so they are not optimized
+// away.
+template<typename Function>
+static void measure(const std::string& name, const std::size_t bytes, Function&& function)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto runs = 0;
+    auto checksum = std::size_t{0};
+    const auto begin = clock::now();
+    auto elapsed = clock::duration{};
+    do
+    {
+        checksum += function();
+        ++runs;
+        elapsed = clock::now() - begin;
+    } while (runs < 5 || elapsed < std::chrono::milliseconds{100});
+
+    const auto seconds = std::chrono::duration<double>{elapsed}.count() / runs;
+    std::cout << name << ": " << seconds * 1e6 << " us per run, ";
+    if (bytes > 0)
+    {
+        std::cout << bytes / seconds / (1 << 20) << " MiB/s (" << bytes / seconds / 1e9 << " GB/s), ";
+    }
+    std::cout << runs << " runs (checksum " << checksum << ")\n";
+}
+
+// Times the first deserialize of the process apart from the later ones. This is the first benchmark in the file, so the
+// call is the first of the process whether the benchmark runs on its own or with the others.
+TEST_CASE("Benchmark first deserialize", "[.][benchmark]")
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto message = std::string{R"({"id":"e01d9d5d","items":[{"count":5,"price":10.5}],"note":"a\"b"})"};
+
+    const auto begin = clock::now();
+    const auto size = Json::deserialize(message).get<Json::object_type>().size();
+    const auto elapsed = std::chrono::duration<double>{clock::now() - begin}.count();
+    std::cout << "first deserialize: " << elapsed * 1e6 << " us (checksum " << size << ")\n";
+
+    measure("later deserialize", message.size(),
+            [&] { return Json::deserialize(message).get<Json::object_type>().size(); });
+}
+
+TEST_CASE("Benchmark deserialize", "[.][benchmark]")
+{
+    const auto orders = makeOrders(10000);
+
+    measure("deserialize", orders.size(), [&] { return Json::deserialize(orders).get<Json::list_type>().size(); });
+}
+
+TEST_CASE("Benchmark deserialize file", "[.][benchmark]")
+{
+    // The file is about 265 MB, so reading it into memory costs as much as parsing a sizeable part of it, even when it
+    // is served from the page cache.
+    const auto path = (std::filesystem::temp_directory_path() / "jelly_benchmark_orders.json").string();
+    {
+        const auto orders = makeOrders(1000);
+        const auto elements = std::string_view{orders}.substr(1, orders.size() - 2);
+        auto file = std::ofstream{path};
+        file << '[';
+        for (auto i = 0; i < 1000; ++i)
+        {
+            file << (i > 0 ? "," : "") << elements;
+        }
+        file << ']';
+    }
+    const auto size = static_cast<std::size_t>(std::filesystem::file_size(path));
+
+    measure("deserialize mapped file", size, [&] { return Json::deserializeFile(path).get<Json::list_type>().size(); });
+
+    measure("read file and deserialize", size,
+            [&]
+            {
+                auto stream = std::ifstream{path};
+                const auto contents = std::string{std::istreambuf_iterator<char>{stream}, {}};
+                return Json::deserialize(contents).get<Json::list_type>().size();
+            });
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Benchmark tokenize", "[.][benchmark]")
+{
+    const auto orders = makeOrders(10000);
+    const auto inputs = std::vector<std::pair<std::string, std::string>>{{"orders", orders},
+                                                                         {"indented orders", indent(orders)},
+                                                                         {"numbers", makeNumbers(200000)},
+                                                                         {"strings", makeStrings(20000)}};
+
+    for (const auto& [name, input] : inputs)
+    {
+        measure("tokenize " + name, input.size(),
+                [&]
+                {
+                    auto tokens = std::size_t{0};
+                    auto tokenizer = Tokenizer{input};
+                    while (tokenizer.hasNext())
+                    {
+                        tokenizer.next();
+                        ++tokens;
+                    }
+                    return tokens;
+                });
+    }
+}
+
+TEST_CASE("Benchmark scan", "[.][benchmark]")
+{
+    const auto orders = makeOrders(10000);
+    const auto classifiers = std::vector<std::pair<std::string, BlockClassifier>>{{"scalar", getScalarClassifier()},
+                                                                                  {"simd", getClassifier()}};
+
+    for (const auto& [name, classifier] : classifiers)
+    {
+        measure("scan with " + name + " classifier", orders.size(),
+                [&]
+                {
+                    auto starts = std::size_t{0};
+                    auto scanner = StructuralScanner{orders, classifier};
+                    while (scanner.next() < static_cast<int>(orders.size()))
+                    {
+                        ++starts;
+                    }
+                    return starts;
+                });
+    }
+}
+
+TEST_CASE("Benchmark deserialize numbers", "[.][benchmark]")
+{
+    const auto numbers = makeNumbers(200000);
+
+    measure("deserialize numbers", numbers.size(),
+            [&] { return Json::deserialize(numbers).get<Json::list_type>().size(); });
+}
+
+TEST_CASE("Benchmark objects", "[.][benchmark]")
+{
+    // 256 members are past the index threshold, so lookups go through the hash table of the shape.
+    for (const auto size : {4, 32, 256})
+    {
+        auto keys = std::vector<std::string>{};
+        for (auto i = 0; i < size; ++i)
+        {
+            keys.push_back("member" + std::to_string(i));
+        }
+        const auto build = [&]
+        {
+            auto object = Json::object();
+            for (auto i = 0; i < size; ++i)
+            {
+                object[keys[i]] = i;
+            }
+            return object;
+        };
+        const auto buildMap = [&]
+        {
+            auto map = std::map<std::string, Json>{};
+            for (auto i = 0; i < size; ++i)
+            {
+                map[keys[i]] = i;
+            }
+            return map;
+        };
+        const auto object = build();
+        const auto& members = object.get<Json::object_type>();
+        const auto map = buildMap();
+        const auto suffix = " (" + std::to_string(size) + " members)";
+
+        measure("build object" + suffix, 0, [&] { return build().get<Json::object_type>().size(); });
+
+        measure("build std::map" + suffix, 0, [&] { return buildMap().size(); });
+
+        measure("look up each member" + suffix, 0,
+                [&]
+                {
+                    auto sum = std::size_t{0};
+                    for (const auto& key : keys)
+                    {
+                        sum += members.at(key).get<int>();
+                    }
+                    return sum;
+                });
+
+        measure("look up each std::map member" + suffix, 0,
+                [&]
+                {
+                    auto sum = std::size_t{0};
+                    for (const auto& key : keys)
+                    {
+                        sum += map.at(key).get<int>();
+                    }
+                    return sum;
+                });
+
+        measure("iterate members" + suffix, 0,
+                [&]
+                {
+                    auto sum = std::size_t{0};
+                    for (auto&& member : members)
+                    {
+                        sum += member.second.get<int>();
+                    }
+                    return sum;
+                });
+
+        measure("iterate std::map members" + suffix, 0,
+                [&]
+                {
+                    auto sum = std::size_t{0};
+                    for (const auto& member : map)
+                    {
+                        sum += member.second.get<int>();
+                    }
+                    return sum;
+                });
+    }
+}
+
+TEST_CASE("Benchmark copy and destroy", "[.][benchmark]")
+{
+    const auto orders = Json::deserialize(makeOrders(10000));
+
+    measure("copy and destroy", 0, [&] { return Json{orders}.get<Json::list_type>().size(); });
+}
+
+TEST_CASE("Benchmark memory", "[.][benchmark]")
+{
+    // Both documents are about 100 MB of text.
+    const auto inputs = std::vector<std::pair<std::string, std::string>>{{"orders", makeOrders(380000)},
+                                                                         {"strings", makeStrings(570000)}};
+
+    std::cout << "json node: " << sizeof(Json) << " bytes\n";
+    for (const auto& [name, input] : inputs)
+    {
+        auto resource = MeasuringResource{};
+        const auto json = dansandu::jelly::json::pmr::Json::deserialize(input, &resource);
+
+        std::cout << "memory of " << name << ": " << input.size() / (1 << 20) << " MiB of text, "
+                  << resource.peakBytes / (1 << 20) << " MiB at peak, " << resource.bytes / (1 << 20)
+                  << " MiB held by the document in " << resource.allocations << " allocations\n";
+    }
+}
+
+TEST_CASE("Benchmark binary", "[.][benchmark]")
+{
+    const auto orders = Json::deserialize(makeOrders(10000));
+    const auto text = orders.serialize();
+    const auto binary = orders.toBinary();
+
+    measure("serialize", text.size(), [&] { return orders.serialize().size(); });
+
+    measure("to binary", binary.size(), [&] { return orders.toBinary().size(); });
+
+    measure("from binary", binary.size(), [&] { return Json::fromBinary(binary).get<Json::list_type>().size(); });
+}
+
+TEST_CASE("Benchmark parse", "[.][benchmark]")
+{
+    const auto orders = makeOrders(10000);
+    auto handler = Handler{};
+
+    measure("parse without building", orders.size(),
+            [&]
+            {
+                dansandu::jelly::sax::parse(orders, handler);
+                return orders.size();
+            });
+
+    const auto message = std::string{R"({"id":1,"ok":true})"};
+
+    measure("parse small message", message.size(),
+            [&]
+            {
+                dansandu::jelly::sax::parse(message, handler);
+                return message.size();
+            });
+}
+
+TEST_CASE("Benchmark reusable parser", "[.][benchmark]")
+{
+    const auto message = std::string{R"({"id":"e01d9d5d","items":[{"count":5,"price":10.5}],"note":"a\"b"})"};
+    auto parser = JsonParser{};
+
+    measure("deserialize small message", message.size(),
+            [&] { return Json::deserialize(message).get<Json::object_type>().size(); });
+
+    measure("reuse parser for small message", message.size(),
+            [&] { return parser.parse(message).get<Json::object_type>().size(); });
+}
+
+TEST_CASE("Benchmark lazy document", "[.][benchmark]")
+{
+    const auto orders = makeOrders(10000);
+
+    measure("parse document and read one order", orders.size(),
+            [&] { return Document::parse(orders)[9999]["items"].size(); });
+
+    measure("parse lazily and read one order", orders.size(),
+            [&] { return Document::parseLazily(orders)[9999]["items"].size(); });
+}
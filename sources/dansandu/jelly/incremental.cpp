@@ -0,0 +1,136 @@
+#include "dansandu/jelly/incremental.hpp"
+#include "dansandu/jelly/internal/builder.hpp"
+#include "dansandu/jelly/internal/matcher.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/internal/token.hpp"
+#include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using dansandu::jelly::internal::builder::JsonBuilder;
+using dansandu::jelly::internal::matcher::StringMatcher;
+using dansandu::jelly::internal::parser::Parser;
+using dansandu::jelly::internal::token::Symbol;
+using dansandu::jelly::internal::tokenizer::Tokenizer;
+using dansandu::jelly::json::Json;
+
+namespace dansandu::jelly::incremental
+{
+
+static bool isNumberCharacter(char c)
+{
+    return ('0' <= c && c <= '9') || c == '+' || c == '-' || c == '.' || c == 'e' || c == 'E';
+}
+
+// Tells whether the unrecognized input could still become a valid token once more characters arrive. A terminated
+// string can only be unrecognized because it failed validation.
+static bool isTokenPrefix(std::string_view string)
+{
+    if (string.front() == '"')
+    {
+        return StringMatcher{Symbol{}}(string).second == 0;
+    }
+    for (const auto literal : {std::string_view{"true"}, std::string_view{"false"}, std::string_view{"null"}})
+    {
+        if (string.size() < literal.size() && literal.substr(0, string.size()) == string)
+        {
+            return true;
+        }
+    }
+    for (const auto c : string)
+    {
+        if (!isNumberCharacter(c))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IncrementalParser::feed(std::string_view chunk)
+{
+    try
+    {
+        if (pending_.empty())
+        {
+            pending_ = chunk.substr(consume(chunk));
+        }
+        else if (pending_.front() == '"' && chunk.find('"') == std::string_view::npos)
+        {
+            pending_ += chunk;
+        }
+        else
+        {
+            pending_ += chunk;
+            pending_.erase(0, consume(pending_));
+        }
+    }
+    catch (...)
+    {
+        reset();
+        throw;
+    }
+}
+
+Json IncrementalParser::finish()
+{
+    try
+    {
+        auto tokenizer = Tokenizer{pending_, options_.validateUtf8};
+        while (tokenizer.hasNext())
+        {
+            parser_.consume(pending_, tokenizer.next(), builder_);
+        }
+        parser_.finish(pending_);
+    }
+    catch (...)
+    {
+        reset();
+        throw;
+    }
+
+    auto json = builder_.release();
+    reset();
+    return json;
+}
+
+void IncrementalParser::reset()
+{
+    builder_ = JsonBuilder{{}, options_.internKeys};
+    parser_ = Parser{};
+    pending_.clear();
+}
+
+std::size_t IncrementalParser::consume(std::string_view json)
+{
+    auto tokenizer = Tokenizer{json, options_.validateUtf8};
+    while (tokenizer.hasNext())
+    {
+        const auto position = tokenizer.getPosition();
+        const auto token = tokenizer.tryNext();
+        if (!token)
+        {
+            if (isTokenPrefix(json.substr(position)))
+            {
+                return position;
+            }
+            // reports the unrecognized symbol
+            tokenizer.next();
+        }
+        else if (token->end() == static_cast<int>(json.size()) &&
+                 (token->getSymbol() == Symbol::integer || token->getSymbol() == Symbol::floatingPoint))
+        {
+            return position;
+        }
+        else
+        {
+            parser_.consume(json, *token, builder_);
+        }
+    }
+    return json.size();
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "dansandu/jelly/internal/builder.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/json.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::incremental
+{
+
+// Deserializes a JSON document that arrives in arbitrary chunks, for example from successive socket reads. Complete
+// tokens are parsed as soon as they are fed and only the trailing token that may continue in the next chunk is kept.
+// After an error the partial document is dropped and the next chunk starts a new one.
+class PRALINE_EXPORT IncrementalParser
+{
+public:
+    explicit IncrementalParser(dansandu::jelly::options::DeserializationOptions options = {})
+        : builder_{{}, options.internKeys}, options_{options}
+    {
+    }
+
+    void feed(std::string_view chunk);
+
+    dansandu::jelly::json::Json finish();
+
+private:
+    std::size_t consume(std::string_view json);
+
+    void reset();
+
+    dansandu::jelly::internal::builder::JsonBuilder builder_;
+    dansandu::jelly::internal::parser::Parser parser_;
+    std::string pending_;
+    dansandu::jelly::options::DeserializationOptions options_;
+};
+
+}
@@ -0,0 +1,93 @@
+#include "dansandu/jelly/incremental.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <string_view>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::incremental::IncrementalParser;
+using dansandu::jelly::json::Json;
+using dansandu::jelly::options::DeserializationOptions;
+
+TEST_CASE("IncrementalParser")
+{
+    auto parser = IncrementalParser{};
+
+    SECTION("split at every position")
+    {
+        const auto string = std::string_view{R"({"id":"f2c4deb09cc1558","values":[-10,0.25,1e3,true,false,null],)"
+                                             R"("empty":{}, "nested" : [[], {"a": 12345}]})"};
+        const auto expected = Json::deserialize(string).serialize();
+
+        for (auto split = 0; split <= static_cast<int>(string.size()); ++split)
+        {
+            parser.feed(string.substr(0, split));
+            parser.feed(string.substr(split));
+
+            REQUIRE(parser.finish().serialize() == expected);
+        }
+    }
+
+    SECTION("one character at a time")
+    {
+        const auto string = std::string_view{R"([123, "some string", -0.5e-3, {"key": null}])"};
+
+        for (const auto character : string)
+        {
+            parser.feed(std::string_view{&character, 1});
+        }
+
+        REQUIRE(parser.finish().serialize() == Json::deserialize(string).serialize());
+    }
+
+    SECTION("number at the end of the input")
+    {
+        parser.feed("1");
+        parser.feed("2");
+
+        REQUIRE(parser.finish().get<int>() == 12);
+    }
+
+    SECTION("bad json")
+    {
+        REQUIRE_THROWS_AS(parser.feed("[1, x"), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(IncrementalParser{}.feed("[1 2]"), JsonDeserializationError);
+
+        auto incomplete = IncrementalParser{};
+        incomplete.feed(R"({"key": "val)");
+
+        REQUIRE_THROWS_AS(incomplete.finish(), JsonDeserializationError);
+    }
+
+    SECTION("error then reuse")
+    {
+        parser.feed(R"({"a": [1, )");
+
+        REQUIRE_THROWS_AS(parser.feed("x]}"), JsonDeserializationError);
+
+        parser.feed(R"({"b": 2})");
+
+        REQUIRE(parser.finish().serialize() == R"({"b":2})");
+
+        parser.feed(R"(["open)");
+
+        REQUIRE_THROWS_AS(parser.finish(), JsonDeserializationError);
+
+        parser.feed("[3]");
+
+        REQUIRE(parser.finish().serialize() == "[3]");
+    }
+
+    SECTION("UTF-8 validation")
+    {
+        auto validating = IncrementalParser{DeserializationOptions{true}};
+        validating.feed("[\"caf\xc3");
+        validating.feed("\xa9\"]");
+
+        REQUIRE(validating.finish()[0].get<Json::string_type>() == "caf\xc3\xa9");
+
+        REQUIRE_THROWS_AS(validating.feed("[\"\xff\", 1"), JsonDeserializationError);
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dansandu::jelly::internal::box
+{
+
+// Owns a single value allocated with the value's own allocator, so that it takes up one pointer wherever it is stored.
+// The allocator is not stored: the value is always constructed with the allocator of its box and is deallocated with
+// the allocator it reports. Boxes are only empty after they are moved from.
+template<typename Type>
+class Box
+{
+    using allocator_type =
+        typename std::allocator_traits<typename Type::allocator_type>::template rebind_alloc<Type>;
+    using traits = std::allocator_traits<allocator_type>;
+
+public:
+    explicit Box(const Type& value)
+        : pointer_{create(traits::select_on_container_copy_construction(allocator_type(value.get_allocator())), value)}
+    {
+    }
+
+    explicit Box(Type&& value) : pointer_{create(allocator_type(value.get_allocator()), std::move(value))}
+    {
+    }
+
+    Box(const Box& other) : Box{*other.pointer_}
+    {
+    }
+
+    Box(Box&& other) noexcept : pointer_{other.pointer_}
+    {
+        other.pointer_ = nullptr;
+    }
+
+    ~Box()
+    {
+        destroy();
+    }
+
+    Box& operator=(const Box& other)
+    {
+        *pointer_ = *other.pointer_;
+        return *this;
+    }
+
+    // The value is moved instead of the pointer when the allocators differ, so it stays in the memory of this box.
+    Box& operator=(Box&& other) noexcept(traits::is_always_equal::value)
+    {
+        if (this != &other)
+        {
+            if (pointer_->get_allocator() == other.pointer_->get_allocator())
+            {
+                destroy();
+                pointer_ = other.pointer_;
+                other.pointer_ = nullptr;
+            }
+            else
+            {
+                *pointer_ = std::move(*other.pointer_);
+            }
+        }
+        return *this;
+    }
+
+    Type& get() noexcept
+    {
+        return *pointer_;
+    }
+
+    const Type& get() const noexcept
+    {
+        return *pointer_;
+    }
+
+private:
+    template<typename Value>
+    static Type* create(allocator_type allocator, Value&& value)
+    {
+        const auto pointer = traits::allocate(allocator, 1);
+        try
+        {
+            traits::construct(allocator, pointer, std::forward<Value>(value));
+        }
+        catch (...)
+        {
+            traits::deallocate(allocator, pointer, 1);
+            throw;
+        }
+        return pointer;
+    }
+
+    void destroy() noexcept
+    {
+        if (pointer_)
+        {
+            auto allocator = allocator_type(pointer_->get_allocator());
+            traits::destroy(allocator, pointer_);
+            traits::deallocate(allocator, pointer_, 1);
+        }
+    }
+
+    Type* pointer_;
+};
+
+template<typename Type>
+const Type& unbox(const Type& value)
+{
+    return value;
+}
+
+template<typename Type>
+const Type& unbox(const Box<Type>& box)
+{
+    return box.get();
+}
+
+}
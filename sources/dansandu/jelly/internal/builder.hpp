@@ -0,0 +1,149 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace dansandu::jelly::internal::builder
+{
+
+template<typename Json>
+class BasicJsonBuilder
+{
+public:
+    using allocator_type = typename Json::string_type::allocator_type;
+
+    explicit BasicJsonBuilder(const allocator_type& allocator = allocator_type{}, bool internKeys = false)
+        : allocator_{allocator}, key_{allocator}, internKeys_{internKeys}
+    {
+    }
+
+    void onNull()
+    {
+        add(Json{});
+    }
+
+    void onBool(bool value)
+    {
+        add(Json{value});
+    }
+
+    void onInt(std::int64_t value)
+    {
+        if (std::numeric_limits<int>::min() <= value && value <= std::numeric_limits<int>::max())
+        {
+            add(Json{static_cast<int>(value)});
+        }
+        else
+        {
+            add(Json{value});
+        }
+    }
+
+    void onUint(std::uint64_t value)
+    {
+        add(Json{value});
+    }
+
+    void onDouble(double value)
+    {
+        add(Json{value});
+    }
+
+    void onString(std::string_view value)
+    {
+        add(Json{typename Json::string_type{value, allocator_}});
+    }
+
+    void onKey(std::string_view key)
+    {
+        key_ = key;
+    }
+
+    void onStartObject()
+    {
+        auto& object = add(Json::object(allocator_));
+        if (internKeys_)
+        {
+            models_.resize(std::max(models_.size(), containers_.size() + 1), typename Json::object_type(allocator_));
+            object.template get<typename Json::object_type>().shareKeys(models_[containers_.size()]);
+        }
+        containers_.push_back(&object);
+    }
+
+    void onEndObject()
+    {
+        if (internKeys_)
+        {
+            auto& model = models_[containers_.size() - 1];
+            model = typename Json::object_type(allocator_);
+            model.shareKeys(containers_.back()->template get<typename Json::object_type>());
+        }
+        containers_.pop_back();
+    }
+
+    void onStartArray()
+    {
+        containers_.push_back(&add(Json::list(0, allocator_)));
+    }
+
+    void onEndArray()
+    {
+        containers_.pop_back();
+    }
+
+    Json release()
+    {
+        return std::move(root_);
+    }
+
+    // Drops a partially built document while keeping the memory of the buffers and the interned keys.
+    void clear()
+    {
+        root_ = Json{};
+        containers_.clear();
+    }
+
+private:
+    Json& add(Json value)
+    {
+        if (containers_.empty())
+        {
+            root_ = std::move(value);
+            return root_;
+        }
+
+        auto& container = *containers_.back();
+        if (container.template is<typename Json::list_type>())
+        {
+            auto& list = container.template get<typename Json::list_type>();
+            list.push_back(std::move(value));
+            return list.back();
+        }
+
+        auto& object = container.template get<typename Json::object_type>();
+        if (auto [position, inserted] = object.try_emplace(key_, std::move(value)); inserted)
+        {
+            return position->second;
+        }
+        THROW(dansandu::jelly::error::JsonDeserializationError, "duplicate key '", key_, "' found in Json object");
+    }
+
+    allocator_type allocator_;
+    Json root_;
+    typename Json::string_type key_;
+    std::vector<Json*> containers_;
+    // Empty objects sharing the keys of the last object completed at each depth.
+    std::vector<typename Json::object_type> models_;
+    bool internKeys_;
+};
+
+using JsonBuilder = BasicJsonBuilder<dansandu::jelly::json::Json>;
+
+}
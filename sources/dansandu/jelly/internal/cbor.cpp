@@ -0,0 +1,135 @@
+#include "dansandu/jelly/internal/cbor.hpp"
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/utf8.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::utf8::isValidUtf8;
+
+namespace dansandu::jelly::internal::cbor
+{
+
+double toDouble(const std::uint8_t info, const std::uint64_t bits)
+{
+    if (info == 25)
+    {
+        const auto exponent = static_cast<int>(bits >> 10 & 0x1f);
+        const auto mantissa = static_cast<double>(bits & 0x3ff);
+        const auto magnitude = exponent == 0    ? std::ldexp(mantissa, -24)
+                               : exponent != 31 ? std::ldexp(mantissa + 1024.0, exponent - 25)
+                               : mantissa == 0  ? std::numeric_limits<double>::infinity()
+                                                : std::numeric_limits<double>::quiet_NaN();
+        return bits & 0x8000 ? -magnitude : magnitude;
+    }
+    if (info == 26)
+    {
+        const auto narrow = static_cast<std::uint32_t>(bits);
+        auto value = 0.0f;
+        std::memcpy(&value, &narrow, sizeof(value));
+        return value;
+    }
+    auto value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+Decoder::Head Decoder::readHead()
+{
+    while (true)
+    {
+        if (position_ == binary_.size())
+        {
+            throwError("unexpected end of input");
+        }
+
+        const auto initial = static_cast<std::uint8_t>(binary_[position_++]);
+        auto head = Head{static_cast<Major>(initial >> 5), static_cast<std::uint8_t>(initial & 31), 0};
+        if (head.info < 24)
+        {
+            head.argument = head.info;
+        }
+        else if (head.info < 28)
+        {
+            const auto bytes = std::size_t{1} << (head.info - 24);
+            if (binary_.size() - position_ < bytes)
+            {
+                throwError("unexpected end of input");
+            }
+            for (auto i = std::size_t{0}; i < bytes; ++i)
+            {
+                head.argument = head.argument << 8 | static_cast<std::uint8_t>(binary_[position_++]);
+            }
+        }
+        else if (head.info != 31 || head.major == unsignedInteger || head.major == negativeInteger ||
+                 head.major == tag)
+        {
+            throwError("malformed head");
+        }
+
+        if (head.major != tag)
+        {
+            return head;
+        }
+    }
+}
+
+std::string_view Decoder::readText(const Head& head)
+{
+    auto text = std::string_view{};
+    if (!head.indefinite())
+    {
+        if (binary_.size() - position_ < head.argument)
+        {
+            throwError("unexpected end of input");
+        }
+        text = binary_.substr(position_, head.argument);
+        position_ += head.argument;
+    }
+    else
+    {
+        buffer_.clear();
+        while (!readBreak())
+        {
+            const auto chunk = readHead();
+            if (chunk.major != textString || chunk.indefinite())
+            {
+                throwError("chunks of text strings must be text strings of definite length");
+            }
+            buffer_ += readText(chunk);
+        }
+        text = buffer_;
+    }
+
+    if (validateUtf8_ && !isValidUtf8(text))
+    {
+        throwError("text string is not valid UTF-8");
+    }
+    return text;
+}
+
+bool Decoder::readBreak()
+{
+    if (position_ == binary_.size())
+    {
+        throwError("unexpected end of input");
+    }
+    if (static_cast<std::uint8_t>(binary_[position_]) == breakValue)
+    {
+        ++position_;
+        return true;
+    }
+    return false;
+}
+
+void Decoder::throwError(const std::string_view message) const
+{
+    THROW(JsonDeserializationError, "invalid binary json at byte ", position_, ": ", message);
+}
+
+}
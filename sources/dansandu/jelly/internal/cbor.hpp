@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Concise Binary Object Representation (RFC 8949) for the JSON data model. Containers are always written with their
+// length up front and doubles take four bytes when that does not lose precision. Both definite and indefinite lengths
+// are accepted when reading, tags are ignored and byte strings or simple values that have no JSON counterpart are
+// rejected.
+namespace dansandu::jelly::internal::cbor
+{
+
+enum Major : std::uint8_t
+{
+    unsignedInteger = 0,
+    negativeInteger = 1,
+    byteString = 2,
+    textString = 3,
+    array = 4,
+    map = 5,
+    tag = 6,
+    simple = 7
+};
+
+constexpr auto falseValue = std::uint8_t{0xf4};
+constexpr auto trueValue = std::uint8_t{0xf5};
+constexpr auto nullValue = std::uint8_t{0xf6};
+constexpr auto floatValue = std::uint8_t{0xfa};
+constexpr auto doubleValue = std::uint8_t{0xfb};
+constexpr auto breakValue = std::uint8_t{0xff};
+
+// Arguments are written in the shortest of the big-endian forms that can hold them.
+template<typename Output>
+void writeHead(Output& output, const Major major, const std::uint64_t argument)
+{
+    char head[9];
+    auto size = std::size_t{0};
+    if (argument < 24)
+    {
+        head[size++] = static_cast<char>(major << 5 | argument);
+    }
+    else
+    {
+        const auto bytes = argument <= 0xff ? 1 : argument <= 0xffff ? 2 : argument <= 0xffffffff ? 4 : 8;
+        head[size++] = static_cast<char>(major << 5 | (bytes == 1 ? 24 : bytes == 2 ? 25 : bytes == 4 ? 26 : 27));
+        for (auto shift = 8 * (bytes - 1); shift >= 0; shift -= 8)
+        {
+            head[size++] = static_cast<char>(argument >> shift);
+        }
+    }
+    output += std::string_view{head, size};
+}
+
+template<typename Output>
+void writeInteger(Output& output, const std::int64_t value)
+{
+    if (value >= 0)
+    {
+        writeHead(output, unsignedInteger, static_cast<std::uint64_t>(value));
+    }
+    else
+    {
+        writeHead(output, negativeInteger, static_cast<std::uint64_t>(-(value + 1)));
+    }
+}
+
+template<typename Output>
+void writeDouble(Output& output, const double value)
+{
+    char bytes[9];
+    auto size = std::size_t{0};
+    if (std::isnan(value) || std::isinf(value) ||
+        (std::fabs(value) <= std::numeric_limits<float>::max() && static_cast<float>(value) == value))
+    {
+        const auto single = static_cast<float>(value);
+        auto bits = std::uint32_t{};
+        std::memcpy(&bits, &single, sizeof(bits));
+        bytes[size++] = static_cast<char>(floatValue);
+        for (auto shift = 24; shift >= 0; shift -= 8)
+        {
+            bytes[size++] = static_cast<char>(bits >> shift);
+        }
+    }
+    else
+    {
+        auto bits = std::uint64_t{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        bytes[size++] = static_cast<char>(doubleValue);
+        for (auto shift = 56; shift >= 0; shift -= 8)
+        {
+            bytes[size++] = static_cast<char>(bits >> shift);
+        }
+    }
+    output += std::string_view{bytes, size};
+}
+
+template<typename Output>
+void writeString(Output& output, const std::string_view string)
+{
+    writeHead(output, textString, string.size());
+    output += string;
+}
+
+// Reports the items of a binary document to the handler with the same events as the text parser. Strings with a
+// definite length are returned as views into the input and chunked strings are joined in a buffer that is reused.
+class Decoder
+{
+public:
+    explicit Decoder(std::string_view binary, bool validateUtf8 = false)
+        : binary_{binary}, position_{0}, validateUtf8_{validateUtf8}
+    {
+    }
+
+    template<typename Handler>
+    void decode(Handler& handler);
+
+private:
+    struct Head
+    {
+        Major major;
+        std::uint8_t info;
+        std::uint64_t argument;
+
+        bool indefinite() const
+        {
+            return info == 31;
+        }
+    };
+
+    struct Container
+    {
+        std::uint64_t remaining;
+        bool object;
+        bool indefinite;
+    };
+
+    // Reads the next head, skipping any tags in front of it.
+    Head readHead();
+
+    std::string_view readText(const Head& head);
+
+    bool readBreak();
+
+    [[noreturn]] void throwError(std::string_view message) const;
+
+    std::string_view binary_;
+    std::size_t position_;
+    std::vector<Container> containers_;
+    std::string buffer_;
+    bool validateUtf8_;
+};
+
+double toDouble(std::uint8_t info, std::uint64_t bits);
+
+template<typename Handler>
+void Decoder::decode(Handler& handler)
+{
+    do
+    {
+        if (!containers_.empty())
+        {
+            auto& container = containers_.back();
+            if (container.indefinite ? readBreak() : container.remaining == 0)
+            {
+                const auto object = container.object;
+                containers_.pop_back();
+                object ? handler.onEndObject() : handler.onEndArray();
+                continue;
+            }
+
+            if (!container.indefinite)
+            {
+                --container.remaining;
+            }
+
+            if (container.object)
+            {
+                const auto key = readHead();
+                if (key.major != textString)
+                {
+                    throwError("object keys must be text strings");
+                }
+                handler.onKey(readText(key));
+            }
+        }
+
+        const auto head = readHead();
+        switch (head.major)
+        {
+        case unsignedInteger:
+            if (head.argument <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+            {
+                handler.onInt(static_cast<std::int64_t>(head.argument));
+            }
+            else
+            {
+                handler.onUint(head.argument);
+            }
+            break;
+        case negativeInteger:
+            if (head.argument <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+            {
+                handler.onInt(-1 - static_cast<std::int64_t>(head.argument));
+            }
+            else
+            {
+                handler.onDouble(-1.0 - static_cast<double>(head.argument));
+            }
+            break;
+        case byteString:
+            throwError("byte strings are not supported");
+        case textString:
+            handler.onString(readText(head));
+            break;
+        case array:
+        case map:
+            containers_.push_back(Container{head.argument, head.major == map, head.indefinite()});
+            head.major == map ? handler.onStartObject() : handler.onStartArray();
+            break;
+        default:
+            if (head.info == (falseValue & 31) || head.info == (trueValue & 31))
+            {
+                handler.onBool(head.info == (trueValue & 31));
+            }
+            else if (head.info == (nullValue & 31))
+            {
+                handler.onNull();
+            }
+            else if (25 <= head.info && head.info <= 27)
+            {
+                handler.onDouble(toDouble(head.info, head.argument));
+            }
+            else if (head.indefinite())
+            {
+                throwError("unexpected break");
+            }
+            else
+            {
+                throwError("unsupported simple value");
+            }
+        }
+    } while (!containers_.empty());
+
+    if (position_ != binary_.size())
+    {
+        throwError("unexpected data after the end of the document");
+    }
+}
+
+}
@@ -0,0 +1,163 @@
+#include "dansandu/jelly/internal/cbor.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/builder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::builder::JsonBuilder;
+using dansandu::jelly::internal::cbor::Decoder;
+using dansandu::jelly::internal::cbor::writeDouble;
+using dansandu::jelly::internal::cbor::writeInteger;
+using dansandu::jelly::internal::cbor::writeString;
+
+static std::string fromHex(const std::string_view hex)
+{
+    auto bytes = std::string{};
+    for (auto i = std::size_t{0}; i < hex.size(); i += 2)
+    {
+        bytes += static_cast<char>(std::stoi(std::string{hex.substr(i, 2)}, nullptr, 16));
+    }
+    return bytes;
+}
+
+static std::string decode(const std::string_view hex, const bool validateUtf8 = false)
+{
+    const auto binary = fromHex(hex);
+    auto builder = JsonBuilder{};
+    auto decoder = Decoder{binary, validateUtf8};
+    decoder.decode(builder);
+    return builder.release().serialize();
+}
+
+// The expected encodings are taken from appendix A of RFC 8949.
+TEST_CASE("Cbor")
+{
+    SECTION("integers")
+    {
+        for (const auto& [value, hex] : {std::pair<std::int64_t, std::string_view>{0, "00"},
+                                         {23, "17"},
+                                         {24, "1818"},
+                                         {100, "1864"},
+                                         {1000, "1903e8"},
+                                         {1000000, "1a000f4240"},
+                                         {1000000000000, "1b000000e8d4a51000"},
+                                         {-1, "20"},
+                                         {-10, "29"},
+                                         {-100, "3863"},
+                                         {-1000, "3903e7"}})
+        {
+            auto binary = std::string{};
+            writeInteger(binary, value);
+
+            REQUIRE(binary == fromHex(hex));
+
+            REQUIRE(decode(hex) == std::to_string(value));
+        }
+
+        REQUIRE(decode("1bffffffffffffffff") == "18446744073709551615");
+
+        REQUIRE(decode("3b7fffffffffffffff") == "-9223372036854775808");
+
+        REQUIRE(decode("3bffffffffffffffff") == "-18446744073709551616.0");
+    }
+
+    SECTION("floating point")
+    {
+        for (const auto& [value, hex] : {std::pair<double, std::string_view>{1.1, "fb3ff199999999999a"},
+                                         {1.5, "fa3fc00000"},
+                                         {100000.0, "fa47c35000"},
+                                         {3.4028234663852886e+38, "fa7f7fffff"},
+                                         {1.0e+300, "fb7e37e43c8800759c"},
+                                         {-4.1, "fbc010666666666666"}})
+        {
+            auto binary = std::string{};
+            writeDouble(binary, value);
+
+            REQUIRE(binary == fromHex(hex));
+        }
+
+        REQUIRE(decode("f90000") == "0.0");
+
+        REQUIRE(decode("f93c00") == "1.0");
+
+        REQUIRE(decode("f97bff") == "65504.0");
+
+        REQUIRE(decode("f90001") == "5.960464477539063e-08");
+
+        REQUIRE(decode("f9c400") == "-4.0");
+
+        REQUIRE(decode("fa47c35000") == "1e+05");
+
+        REQUIRE(decode("fb3ff199999999999a") == "1.1");
+    }
+
+    SECTION("strings")
+    {
+        auto binary = std::string{};
+        writeString(binary, "IETF");
+
+        REQUIRE(binary == fromHex("6449455446"));
+
+        REQUIRE(decode("60") == R"("")");
+
+        REQUIRE(decode("6449455446") == R"("IETF")");
+
+        REQUIRE(decode("62225c") == R"("\"\\")");
+
+        REQUIRE(decode("7f657374726561646d696e67ff") == R"("streaming")");
+    }
+
+    SECTION("simple values")
+    {
+        REQUIRE(decode("f4") == "false");
+
+        REQUIRE(decode("f5") == "true");
+
+        REQUIRE(decode("f6") == "null");
+    }
+
+    SECTION("containers")
+    {
+        REQUIRE(decode("80") == "[]");
+
+        REQUIRE(decode("83010203") == "[1,2,3]");
+
+        REQUIRE(decode("8301820203820405") == "[1,[2,3],[4,5]]");
+
+        REQUIRE(decode("a0") == "{}");
+
+        REQUIRE(decode("a26161016162820203") == R"({"a":1,"b":[2,3]})");
+
+        REQUIRE(decode("9fff") == "[]");
+
+        REQUIRE(decode("9f018202039f0405ffff") == "[1,[2,3],[4,5]]");
+
+        REQUIRE(decode("bf61610161629f0203ffff") == R"({"a":1,"b":[2,3]})");
+
+        REQUIRE(decode("826161bf61626163ff") == R"(["a",{"b":"c"}])");
+    }
+
+    SECTION("tags are ignored")
+    {
+        REQUIRE(decode("c11a514b67b0") == "1363896240");
+
+        REQUIRE(decode("c074323031332d30332d32315432303a30343a30305a") == R"("2013-03-21T20:04:00Z")");
+    }
+
+    SECTION("invalid")
+    {
+        for (const auto hex : {"", "18", "1b0000", "62ff", "8301", "a16161", "bf6161", "f7", "f8ff", "ff", "4161",
+                               "a10101", "0101", "1c", "3f", "9f01", "7f6161", "7f01ff", "a2616101616102"})
+        {
+            REQUIRE_THROWS_AS(decode(hex), JsonDeserializationError);
+        }
+
+        REQUIRE(decode("62c3a9") == "\"\xc3\xa9\"");
+
+        REQUIRE_THROWS_AS(decode("62c0af", true), JsonDeserializationError);
+    }
+}
@@ -0,0 +1,21 @@
+#include "dansandu/jelly/internal/context.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::internal::context
+{
+
+std::string formatContext(const std::string_view input, const std::size_t position)
+{
+    constexpr auto radius = std::size_t{32};
+    const auto begin = position > radius ? position - radius : 0;
+    auto context = std::string{input.substr(begin, position - begin + radius)};
+    context += '\n';
+    context.append(position - begin, ' ');
+    context += '^';
+    return context;
+}
+
+}
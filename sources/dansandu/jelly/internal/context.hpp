@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::internal::context
+{
+
+// Returns the part of the input around the position followed by a line with a caret under the position. Only a few
+// dozen characters on each side are kept, so error messages stay short when the input is large.
+std::string formatContext(std::string_view input, std::size_t position);
+
+}
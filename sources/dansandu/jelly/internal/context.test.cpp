@@ -0,0 +1,26 @@
+#include "dansandu/jelly/internal/context.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <string>
+
+using dansandu::jelly::internal::context::formatContext;
+
+TEST_CASE("Context")
+{
+    SECTION("short input")
+    {
+        REQUIRE(formatContext("[1, 2 3]", 6) == "[1, 2 3]\n      ^");
+
+        REQUIRE(formatContext("[1, 2", 5) == "[1, 2\n     ^");
+    }
+
+    SECTION("long input")
+    {
+        const auto input = std::string(100, 'a') + "!" + std::string(100, 'b');
+
+        REQUIRE(formatContext(input, 100) ==
+                std::string(32, 'a') + "!" + std::string(31, 'b') + "\n" + std::string(32, ' ') + "^");
+
+        REQUIRE(formatContext(input, 3) == std::string(35, 'a') + "\n   ^");
+    }
+}
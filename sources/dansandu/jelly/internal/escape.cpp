@@ -0,0 +1,214 @@
+#include "dansandu/jelly/internal/escape.hpp"
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/jelly/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define JELLY_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using dansandu::jelly::error::JsonDeserializationError;
+
+namespace dansandu::jelly::internal::escape
+{
+
+static bool isEscapable(char c)
+{
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+std::size_t findEscapable(std::string_view string)
+{
+    auto position = std::size_t{0};
+#ifdef JELLY_SSE2
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto lastControl = _mm_set1_epi8(0x1F);
+    for (; position + 16 <= string.size(); position += 16)
+    {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + position));
+        // a byte is at most 0x1F exactly when its unsigned minimum with 0x1F is itself
+        const auto matches =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+                         _mm_cmpeq_epi8(_mm_min_epu8(bytes, lastControl), bytes));
+        if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)))
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return position + index;
+#else
+            return position + __builtin_ctz(mask);
+#endif
+        }
+    }
+#endif
+    while (position < string.size() && !isEscapable(string[position]))
+    {
+        ++position;
+    }
+    return position;
+}
+
+std::string_view getEscapeSequence(char character)
+{
+    static constexpr const char* controls[] = {
+        "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+        "\\b",     "\\t",     "\\n",     "\\u000b", "\\f",     "\\r",     "\\u000e", "\\u000f",
+        "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+        "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"};
+
+    if (character == '"')
+    {
+        return "\\\"";
+    }
+    if (character == '\\')
+    {
+        return "\\\\";
+    }
+    return controls[static_cast<unsigned char>(character)];
+}
+
+static int parseHexadecimal(std::string_view string, std::size_t position)
+{
+    if (position + 4 > string.size())
+    {
+        THROW(JsonDeserializationError, "incomplete unicode escape sequence in string '", string, "'");
+    }
+    auto value = 0;
+    for (auto i = position; i < position + 4; ++i)
+    {
+        const auto c = string[i];
+        value <<= 4;
+        if ('0' <= c && c <= '9')
+        {
+            value |= c - '0';
+        }
+        else if ('a' <= c && c <= 'f')
+        {
+            value |= c - 'a' + 10;
+        }
+        else if ('A' <= c && c <= 'F')
+        {
+            value |= c - 'A' + 10;
+        }
+        else
+        {
+            THROW(JsonDeserializationError, "invalid unicode escape sequence in string '", string, "'");
+        }
+    }
+    return value;
+}
+
+static void appendUtf8(std::uint32_t codePoint, std::string& output)
+{
+    if (codePoint < 0x80)
+    {
+        output += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        output += static_cast<char>(0xC0 | (codePoint >> 6));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        output += static_cast<char>(0xE0 | (codePoint >> 12));
+        output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        output += static_cast<char>(0xF0 | (codePoint >> 18));
+        output += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+void unescape(std::string_view string, std::string& output)
+{
+    auto position = std::size_t{0};
+    while (position < string.size())
+    {
+        const auto backslash = string.find('\\', position);
+        if (backslash == std::string_view::npos)
+        {
+            output += string.substr(position);
+            break;
+        }
+        output += string.substr(position, backslash - position);
+        if (backslash + 1 == string.size())
+        {
+            THROW(JsonDeserializationError, "incomplete escape sequence in string '", string, "'");
+        }
+
+        position = backslash + 2;
+        switch (string[backslash + 1])
+        {
+        case '"':
+            output += '"';
+            break;
+        case '\\':
+            output += '\\';
+            break;
+        case '/':
+            output += '/';
+            break;
+        case 'b':
+            output += '\b';
+            break;
+        case 'f':
+            output += '\f';
+            break;
+        case 'n':
+            output += '\n';
+            break;
+        case 'r':
+            output += '\r';
+            break;
+        case 't':
+            output += '\t';
+            break;
+        case 'u':
+        {
+            auto codePoint = static_cast<std::uint32_t>(parseHexadecimal(string, position));
+            position += 4;
+            if (0xD800 <= codePoint && codePoint <= 0xDBFF)
+            {
+                if (string.substr(position, 2) != "\\u")
+                {
+                    THROW(JsonDeserializationError, "unpaired surrogate in string '", string, "'");
+                }
+                const auto low = static_cast<std::uint32_t>(parseHexadecimal(string, position + 2));
+                if (low < 0xDC00 || low > 0xDFFF)
+                {
+                    THROW(JsonDeserializationError, "unpaired surrogate in string '", string, "'");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                position += 6;
+            }
+            else if (0xDC00 <= codePoint && codePoint <= 0xDFFF)
+            {
+                THROW(JsonDeserializationError, "unpaired surrogate in string '", string, "'");
+            }
+            appendUtf8(codePoint, output);
+            break;
+        }
+        default:
+            THROW(JsonDeserializationError, "invalid escape sequence '\\", string[backslash + 1], "' in string '",
+                  string, "'");
+        }
+    }
+}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::internal::escape
+{
+
+// Returns the position of the first character that has to be escaped inside a JSON string, which is a quote, a
+// backslash or a control character, or the size of the string if there is none.
+std::size_t findEscapable(std::string_view string);
+
+// Returns the escape sequence of a character found by findEscapable.
+std::string_view getEscapeSequence(char character);
+
+// Decodes the escape sequences of the contents of a JSON string, including \uXXXX escapes and surrogate pairs which
+// are converted to UTF-8, and appends the result to the output.
+void unescape(std::string_view string, std::string& output);
+
+template<typename Output>
+void escape(std::string_view string, Output& output)
+{
+    while (!string.empty())
+    {
+        const auto position = findEscapable(string);
+        output += string.substr(0, position);
+        if (position == string.size())
+        {
+            break;
+        }
+        output += getEscapeSequence(string[position]);
+        string.remove_prefix(position + 1);
+    }
+}
+
+}
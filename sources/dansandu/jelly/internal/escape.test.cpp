@@ -0,0 +1,63 @@
+#include "dansandu/jelly/internal/escape.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+
+#include <string>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::escape::escape;
+using dansandu::jelly::internal::escape::findEscapable;
+using dansandu::jelly::internal::escape::unescape;
+
+static std::string unescaped(std::string_view string)
+{
+    auto output = std::string{};
+    unescape(string, output);
+    return output;
+}
+
+TEST_CASE("Escape")
+{
+    SECTION("findEscapable")
+    {
+        REQUIRE(findEscapable("") == 0);
+
+        REQUIRE(findEscapable("plain text without special characters") == 37);
+
+        REQUIRE(findEscapable("0123456789abcdef0123\"") == 20);
+
+        REQUIRE(findEscapable("0123456789abcdef0123456789abcdef\\") == 32);
+
+        REQUIRE(findEscapable(std::string_view{"ab\0c", 4}) == 2);
+
+        REQUIRE(findEscapable("\xc3\xa9\x7f\x1f") == 3);
+    }
+
+    SECTION("escape")
+    {
+        auto output = std::string{};
+
+        escape("a\"b\\c\nd\x01\x7f", output);
+
+        REQUIRE(output == R"(a\"b\\c\nd\u0001)" "\x7f");
+    }
+
+    SECTION("unescape")
+    {
+        REQUIRE(unescaped("no escapes") == "no escapes");
+
+        REQUIRE(unescaped(R"(\"\\\/\b\f\n\r\t)") == "\"\\/\b\f\n\r\t");
+
+        REQUIRE(unescaped(R"(\u0061\u0041\u00e9\u20AC)") == "aA\xc3\xa9\xe2\x82\xac");
+
+        REQUIRE(unescaped(R"(\ud83d\ude00!)") == "\xf0\x9f\x98\x80!");
+    }
+
+    SECTION("invalid escapes")
+    {
+        for (const auto string : {R"(\x)", R"(\)", R"(\u12)", R"(\u12g4)", R"(\ud83d)", R"(\ud83dA)", R"(\ude00)"})
+        {
+            REQUIRE_THROWS_AS(unescaped(string), JsonDeserializationError);
+        }
+    }
+}
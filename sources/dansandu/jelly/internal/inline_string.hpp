@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string_view>
+
+namespace dansandu::jelly::internal::inline_string
+{
+
+// Holds a string of up to capacity characters in place of the pointer of a box, so that short strings take up no more
+// room than a number and need no allocation.
+class InlineString
+{
+public:
+    static constexpr auto capacity = sizeof(void*) - 1;
+
+    static bool fits(std::string_view string) noexcept
+    {
+        return string.size() <= capacity;
+    }
+
+    explicit InlineString(std::string_view string) noexcept : size_{static_cast<unsigned char>(string.size())}
+    {
+        string.copy(characters_, string.size());
+    }
+
+    std::string_view view() const noexcept
+    {
+        return {characters_, size_};
+    }
+
+private:
+    char characters_[capacity];
+    unsigned char size_;
+};
+
+// Reads an inline string like the value of a box, so that both kinds of strings can be handled as a std::string_view.
+inline std::string_view unbox(const InlineString& string) noexcept
+{
+    return string.view();
+}
+
+}
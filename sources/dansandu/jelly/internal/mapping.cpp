@@ -0,0 +1,114 @@
+#include "dansandu/jelly/internal/mapping.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dansandu::jelly::internal::mapping
+{
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+    : data_{nullptr}, size_{0}, file_{INVALID_HANDLE_VALUE}, mapping_{nullptr}
+{
+    file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        THROW(std::runtime_error, "could not open file '", path, "'");
+    }
+
+    auto size = LARGE_INTEGER{};
+    if (!::GetFileSizeEx(file_, &size))
+    {
+        ::CloseHandle(file_);
+        THROW(std::runtime_error, "could not read the size of file '", path, "'");
+    }
+
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ > 0)
+    {
+        mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr)
+        {
+            ::CloseHandle(file_);
+            THROW(std::runtime_error, "could not map file '", path, "'");
+        }
+
+        data_ = static_cast<const char*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr)
+        {
+            ::CloseHandle(mapping_);
+            ::CloseHandle(file_);
+            THROW(std::runtime_error, "could not map file '", path, "'");
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        ::UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr)
+    {
+        ::CloseHandle(mapping_);
+    }
+    ::CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : data_{nullptr}, size_{0}
+{
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        THROW(std::runtime_error, "could not open file '", path, "'");
+    }
+
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        THROW(std::runtime_error, "could not read the size of file '", path, "'");
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0)
+    {
+        const auto data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(descriptor);
+            THROW(std::runtime_error, "could not map file '", path, "'");
+        }
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+
+    ::close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#endif
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::internal::mapping
+{
+
+// Read-only memory mapping of a whole file. The contents stay valid for as long as the object lives.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    std::string_view getContents() const
+    {
+        return {data_, size_};
+    }
+
+private:
+    const char* data_;
+    std::size_t size_;
+#ifdef _WIN32
+    void* file_;
+    void* mapping_;
+#endif
+};
+
+}
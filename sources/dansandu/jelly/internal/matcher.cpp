@@ -4,7 +4,7 @@
 #include <string>
 #include <string_view>
 
-using dansandu::glyph::symbol::Symbol;
+using dansandu::jelly::internal::token::Symbol;
 
 namespace dansandu::jelly::internal::matcher
 {
@@ -31,24 +31,13 @@ static bool isFraction(char c)
 
 std::pair<Symbol, int> ExactMatcher::operator()(std::string_view string) const
 {
-    if (string.substr(0, std::min(string.size(), string_.size())) == string_)
+    if (string.compare(0, string_.size(), string_) == 0)
     {
         return {symbol_, static_cast<int>(string_.size())};
     }
     return {Symbol{}, 0};
 }
 
-std::pair<Symbol, int> WhitespaceMatcher::operator()(std::string_view string) const
-{
-    auto position = string.cbegin();
-    while (position != string.cend() && std::isspace(*position))
-    {
-        ++position;
-    }
-    auto size = static_cast<int>(position - string.cbegin());
-    return {size > 0 ? symbol_ : Symbol{}, size};
-}
-
 std::pair<Symbol, int> NumberMatcher::operator()(std::string_view string) const
 {
     auto position = string.cbegin();
@@ -110,20 +99,29 @@ std::pair<Symbol, int> NumberMatcher::operator()(std::string_view string) const
     return {Symbol{}, 0};
 }
 
+// Jumps from quote to quote instead of walking the string. A quote preceded by an odd number of backslashes is escaped
+// and does not end the string.
 std::pair<Symbol, int> StringMatcher::operator()(std::string_view string) const
 {
-    auto position = string.cbegin();
-    if (position != string.cend() && *position == '"')
+    if (!string.empty() && string.front() == '"')
     {
-        ++position;
-        while (position != string.cend() && *position != '"')
-        {
-            ++position;
-        }
-        if (position != string.cend())
+        auto position = std::size_t{1};
+        while ((position = string.find('"', position)) != std::string_view::npos)
         {
+            auto backslashes = std::size_t{0};
+            while (string[position - backslashes - 1] == '\\')
+            {
+                ++backslashes;
+            }
             ++position;
-            return {symbol_, static_cast<int>(position - string.cbegin())};
+            if (backslashes % 2 == 0)
+            {
+                if (validator_ && !validator_(string.substr(1, position - 2)))
+                {
+                    break;
+                }
+                return {symbol_, static_cast<int>(position)};
+            }
         }
     }
     return {Symbol{}, 0};
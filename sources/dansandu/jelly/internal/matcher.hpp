@@ -1,10 +1,11 @@
 #pragma once
 
-#include "dansandu/glyph/symbol.hpp"
+#include "dansandu/jelly/internal/token.hpp"
+#include "dansandu/jelly/internal/utf8.hpp"
 
 #include <string>
 #include <string_view>
-#include <type_traits>
+#include <utility>
 
 namespace dansandu::jelly::internal::matcher
 {
@@ -12,117 +13,48 @@ namespace dansandu::jelly::internal::matcher
 class ExactMatcher
 {
 public:
-    ExactMatcher(dansandu::glyph::symbol::Symbol symbol, std::string string)
-        : symbol_{symbol}, string_{std::move(string)}
+    ExactMatcher(dansandu::jelly::internal::token::Symbol symbol, std::string_view string)
+        : symbol_{symbol}, string_{string}
     {
     }
 
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const;
+    std::pair<dansandu::jelly::internal::token::Symbol, int> operator()(std::string_view string) const;
 
 private:
-    dansandu::glyph::symbol::Symbol symbol_;
-    std::string string_;
-};
-
-class WhitespaceMatcher
-{
-public:
-    explicit WhitespaceMatcher(dansandu::glyph::symbol::Symbol symbol) : symbol_{symbol}
-    {
-    }
-
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const;
-
-private:
-    dansandu::glyph::symbol::Symbol symbol_;
+    dansandu::jelly::internal::token::Symbol symbol_;
+    std::string_view string_;
 };
 
 class NumberMatcher
 {
 public:
-    NumberMatcher(dansandu::glyph::symbol::Symbol integer, dansandu::glyph::symbol::Symbol floatingPoint)
+    NumberMatcher(dansandu::jelly::internal::token::Symbol integer,
+                  dansandu::jelly::internal::token::Symbol floatingPoint)
         : integer_{integer}, floatingPoint_{floatingPoint}
     {
     }
 
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const;
+    std::pair<dansandu::jelly::internal::token::Symbol, int> operator()(std::string_view string) const;
 
 private:
-    dansandu::glyph::symbol::Symbol integer_;
-    dansandu::glyph::symbol::Symbol floatingPoint_;
+    dansandu::jelly::internal::token::Symbol integer_;
+    dansandu::jelly::internal::token::Symbol floatingPoint_;
 };
 
+// Strings that are not valid UTF-8 are not matched when validation is enabled.
 class StringMatcher
 {
 public:
-    explicit StringMatcher(dansandu::glyph::symbol::Symbol symbol) : symbol_{symbol}
+    explicit StringMatcher(dansandu::jelly::internal::token::Symbol symbol, bool validateUtf8 = false)
+        : symbol_{symbol}, validator_{validateUtf8 ? dansandu::jelly::internal::utf8::getValidator() : nullptr}
     {
     }
 
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const;
+    std::pair<dansandu::jelly::internal::token::Symbol, int> operator()(std::string_view string) const;
 
 private:
-    dansandu::glyph::symbol::Symbol symbol_;
+    dansandu::jelly::internal::token::Symbol symbol_;
+    dansandu::jelly::internal::utf8::Utf8Validator validator_;
 };
 
-template<typename Matcher, typename... Matchers>
-class FallbackMatcher;
-
-template<typename Matcher>
-class FallbackMatcher<Matcher>
-{
-public:
-    template<typename M>
-    FallbackMatcher(M&& matcher) : matcher_{std::move(matcher)}
-    {
-    }
-
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const
-    {
-        if (auto match = matcher_(string); match.second > 0)
-        {
-            return match;
-        }
-        else
-        {
-            return {dansandu::glyph::symbol::Symbol{}, 0};
-        }
-    }
-
-private:
-    Matcher matcher_;
-};
-
-template<typename Matcher, typename... Matchers>
-class FallbackMatcher : private FallbackMatcher<Matchers...>
-{
-public:
-    template<typename M, typename... MM>
-    FallbackMatcher(M&& matcher, MM&&... matchers)
-        : FallbackMatcher<Matchers...>{std::forward<MM>(matchers)...}, matcher_{std::move(matcher)}
-    {
-    }
-
-    std::pair<dansandu::glyph::symbol::Symbol, int> operator()(std::string_view string) const
-    {
-        if (auto match = matcher_(string); match.second > 0)
-        {
-            return match;
-        }
-        else
-        {
-            return FallbackMatcher<Matchers...>::operator()(string);
-        }
-    }
-
-private:
-    Matcher matcher_;
-};
-
-template<typename... Matchers>
-auto makeFallbackMatcher(Matchers&&... matchers)
-{
-    return FallbackMatcher<std::decay_t<Matchers>...>(std::forward<Matchers>(matchers)...);
-}
-
 }
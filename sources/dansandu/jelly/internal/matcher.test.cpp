@@ -1,13 +1,11 @@
 #include "dansandu/jelly/internal/matcher.hpp"
 #include "catchorg/catch/catch.hpp"
-#include "dansandu/glyph/symbol.hpp"
+#include "dansandu/jelly/internal/token.hpp"
 
-using dansandu::glyph::symbol::Symbol;
 using dansandu::jelly::internal::matcher::ExactMatcher;
-using dansandu::jelly::internal::matcher::makeFallbackMatcher;
 using dansandu::jelly::internal::matcher::NumberMatcher;
 using dansandu::jelly::internal::matcher::StringMatcher;
-using dansandu::jelly::internal::matcher::WhitespaceMatcher;
+using dansandu::jelly::internal::token::Symbol;
 
 using Match = std::pair<Symbol, int>;
 
@@ -29,37 +27,6 @@ TEST_CASE("Matcher")
         REQUIRE(matcher("") == noMatch);
     }
 
-    SECTION("FallbackMatcher")
-    {
-        auto first = Symbol{1};
-        auto second = Symbol{2};
-        auto third = Symbol{3};
-        auto matcher =
-            makeFallbackMatcher(ExactMatcher{first, "+++"}, ExactMatcher{second, "++"}, ExactMatcher{third, "+"});
-
-        REQUIRE(matcher("") == noMatch);
-
-        REQUIRE(matcher("+") == Match{third, 1});
-
-        REQUIRE(matcher("++") == Match{second, 2});
-
-        REQUIRE(matcher("+++") == Match{first, 3});
-
-        REQUIRE(matcher("++++") == Match{first, 3});
-    }
-
-    SECTION("WhitespaceMatcher")
-    {
-        auto symbol = Symbol{1};
-        auto matcher = WhitespaceMatcher{symbol};
-
-        REQUIRE(matcher("  \n \t f()") == Match{symbol, 6});
-
-        REQUIRE(matcher("") == noMatch);
-
-        REQUIRE(matcher("9.0   ") == noMatch);
-    }
-
     SECTION("NumberMatcher")
     {
         auto integer = Symbol{1};
@@ -140,5 +107,25 @@ TEST_CASE("Matcher")
         REQUIRE(matcher("\"hello world!\"") == Match{symbol, 14});
 
         REQUIRE(matcher("\"yada yada yada\n new paragraph\" after") == Match{symbol, 31});
+
+        REQUIRE(matcher(R"("escaped \" quote" after)") == Match{symbol, 18});
+
+        REQUIRE(matcher(R"("escaped backslash \\" after)") == Match{symbol, 22});
+
+        REQUIRE(matcher(R"("unterminated \")") == noMatch);
+
+        REQUIRE(matcher("\"invalid \xff utf-8\"") == Match{symbol, 17});
+    }
+
+    SECTION("StringMatcher with UTF-8 validation")
+    {
+        const auto symbol = Symbol{1};
+        const auto matcher = StringMatcher{symbol, true};
+
+        REQUIRE(matcher("\"caf\xc3\xa9\" after") == Match{symbol, 7});
+
+        REQUIRE(matcher("\"invalid \xff utf-8\"") == noMatch);
+
+        REQUIRE(matcher("\"truncated \xe2\x82\"") == noMatch);
     }
 }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "dansandu/jelly/sink.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dansandu::jelly::internal::output
+{
+
+// Collects the serialized text in a fixed size buffer and hands it to the sink whenever the buffer fills up.
+class ChunkedOutput
+{
+public:
+    static constexpr auto chunkSize = std::size_t{64 * 1024};
+
+    explicit ChunkedOutput(dansandu::jelly::sink::Sink& sink) : sink_{sink}
+    {
+        buffer_.reserve(chunkSize);
+    }
+
+    ChunkedOutput& operator+=(char character)
+    {
+        if (buffer_.size() == chunkSize)
+        {
+            flush();
+        }
+        buffer_ += character;
+        return *this;
+    }
+
+    ChunkedOutput& operator+=(std::string_view string)
+    {
+        if (buffer_.size() + string.size() > chunkSize)
+        {
+            flush();
+            if (string.size() > chunkSize)
+            {
+                sink_.write(string);
+                return *this;
+            }
+        }
+        buffer_ += string;
+        return *this;
+    }
+
+    void flush()
+    {
+        if (!buffer_.empty())
+        {
+            sink_.write(buffer_);
+            buffer_.clear();
+        }
+    }
+
+private:
+    dansandu::jelly::sink::Sink& sink_;
+    std::string buffer_;
+};
+
+}
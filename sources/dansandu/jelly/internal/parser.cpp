@@ -0,0 +1,85 @@
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/context.hpp"
+#include "dansandu/jelly/internal/token.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::context::formatContext;
+using dansandu::jelly::internal::token::Token;
+
+namespace dansandu::jelly::internal::parser
+{
+
+void throwUnexpectedToken(std::string_view json, const Token& token)
+{
+    THROW(JsonDeserializationError, "unexpected token '", json.substr(token.begin(), token.end() - token.begin()),
+          "' at position ", token.begin() + 1, " in input string:\n", formatContext(json, token.begin()));
+}
+
+// Tells whether a number that is out of range is too close to zero rather than too large. The decimal exponent of its
+// first significant digit is enough for that, since doubles only run out at about 1e-324 and 1e308.
+static bool isTooSmall(const std::string_view lexeme)
+{
+    const auto exponentBegin = lexeme.find_first_of("eE");
+    const auto mantissa = lexeme.substr(0, exponentBegin);
+    const auto point = std::min(mantissa.find('.'), mantissa.size());
+    const auto significant = mantissa.find_first_of("123456789");
+    if (significant == std::string_view::npos)
+    {
+        return true;
+    }
+
+    auto magnitude = significant < point ? static_cast<long long>(point - significant)
+                                         : -static_cast<long long>(significant - point - 1);
+    if (exponentBegin != std::string_view::npos)
+    {
+        auto exponentDigits = lexeme.substr(exponentBegin + 1);
+        const auto negative = exponentDigits.front() == '-';
+        if (exponentDigits.front() == '-' || exponentDigits.front() == '+')
+        {
+            exponentDigits.remove_prefix(1);
+        }
+        auto exponent = 0LL;
+        if (std::from_chars(exponentDigits.data(), exponentDigits.data() + exponentDigits.size(), exponent).ec !=
+            std::errc{})
+        {
+            return negative;
+        }
+        magnitude += negative ? -exponent : exponent;
+    }
+    return magnitude <= 0;
+}
+
+// Numbers too close to zero become zero with the sign of the number, like strtod, and only numbers too large for a
+// double are rejected.
+double parseFloatingPoint(std::string_view lexeme)
+{
+    if (lexeme.front() == '+')
+    {
+        lexeme.remove_prefix(1);
+    }
+    auto value = 0.0;
+    if (std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value).ec != std::errc{})
+    {
+        if (!isTooSmall(lexeme))
+        {
+            THROW(JsonDeserializationError, "number ", lexeme, " is out of range");
+        }
+        value = lexeme.front() == '-' ? -0.0 : 0.0;
+    }
+    return value;
+}
+
+void throwUnexpectedEnd(std::string_view json)
+{
+    THROW(JsonDeserializationError, "unexpected end of input string:\n", formatContext(json, json.size()));
+}
+
+}
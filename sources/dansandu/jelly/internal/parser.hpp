@@ -0,0 +1,315 @@
+#pragma once
+
+#include "dansandu/jelly/internal/escape.hpp"
+#include "dansandu/jelly/internal/token.hpp"
+#include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace dansandu::jelly::internal::parser
+{
+
+[[noreturn]] void throwUnexpectedToken(std::string_view json, const dansandu::jelly::internal::token::Token& token);
+
+[[noreturn]] void throwUnexpectedEnd(std::string_view json);
+
+double parseFloatingPoint(std::string_view lexeme);
+
+enum class Expected : unsigned char
+{
+    value,
+    valueOrArrayEnd,
+    key,
+    keyOrObjectEnd,
+    colon,
+    commaOrObjectEnd,
+    commaOrArrayEnd,
+    nothing
+};
+
+enum class Action : unsigned char
+{
+    reject,
+    skip,
+    null,
+    trueBoolean,
+    falseBoolean,
+    integer,
+    floatingPoint,
+    string,
+    startObject,
+    endObject,
+    startArray,
+    endArray,
+    key,
+    colon,
+    objectComma,
+    arrayComma
+};
+
+using ParseTable = std::array<std::array<Action, dansandu::jelly::internal::token::symbolCount>,
+                              static_cast<int>(Expected::nothing) + 1>;
+
+// Builds the LL(1) table of the JSON grammar, which tells what to do with each terminal in each parser state. Entries
+// that are left out are syntax errors.
+constexpr ParseTable makeParseTable()
+{
+    using dansandu::jelly::internal::token::Symbol;
+
+    auto table = ParseTable{};
+    const auto set = [&table](Expected expected, Symbol symbol, Action action)
+    { table[static_cast<int>(expected)][static_cast<int>(symbol)] = action; };
+
+    for (auto expected = 0; expected < static_cast<int>(table.size()); ++expected)
+    {
+        set(static_cast<Expected>(expected), Symbol::whitespace, Action::skip);
+    }
+    for (const auto expected : {Expected::value, Expected::valueOrArrayEnd})
+    {
+        set(expected, Symbol::null, Action::null);
+        set(expected, Symbol::trueBoolean, Action::trueBoolean);
+        set(expected, Symbol::falseBoolean, Action::falseBoolean);
+        set(expected, Symbol::integer, Action::integer);
+        set(expected, Symbol::floatingPoint, Action::floatingPoint);
+        set(expected, Symbol::string, Action::string);
+        set(expected, Symbol::objectBegin, Action::startObject);
+        set(expected, Symbol::arrayBegin, Action::startArray);
+    }
+    set(Expected::valueOrArrayEnd, Symbol::arrayEnd, Action::endArray);
+    set(Expected::key, Symbol::string, Action::key);
+    set(Expected::keyOrObjectEnd, Symbol::string, Action::key);
+    set(Expected::keyOrObjectEnd, Symbol::objectEnd, Action::endObject);
+    set(Expected::colon, Symbol::colon, Action::colon);
+    set(Expected::commaOrObjectEnd, Symbol::comma, Action::objectComma);
+    set(Expected::commaOrObjectEnd, Symbol::objectEnd, Action::endObject);
+    set(Expected::commaOrArrayEnd, Symbol::comma, Action::arrayComma);
+    set(Expected::commaOrArrayEnd, Symbol::arrayEnd, Action::endArray);
+    return table;
+}
+
+// Computed by the compiler, so the first document is parsed as fast as any other.
+inline constexpr auto parseTable = makeParseTable();
+
+// Predictive JSON parser that is fed one token at a time and reports every value to the handler as soon as it is
+// recognized. Only the states to return to after the currently open containers are kept, on an explicit stack, so
+// deeply nested input cannot overflow the call stack and parsing can be suspended between any two tokens.
+class Parser
+{
+public:
+    // Parses a whole document. The parser can be reused afterwards, even if the document was invalid, and keeps the
+    // memory of its buffers.
+    template<typename Handler>
+    void parse(std::string_view json, Handler& handler, bool validateUtf8 = false);
+
+    // Parses a whole document but passes over the lists and objects the handler does not want. The handler is asked
+    // through skips() whenever a container starts and the positions of the skipped ones are reported to onSkipped. The
+    // contents of a skipped container are not tokenized, so only its brackets are checked. Parsing starts at the given
+    // position, so that tokens and errors inside a part of a larger input keep their positions in that input.
+    template<typename Handler>
+    void parseSkipping(std::string_view json, Handler& handler, bool validateUtf8 = false, int begin = 0);
+
+    template<typename Handler>
+    void consume(std::string_view json, const dansandu::jelly::internal::token::Token& token, Handler& handler);
+
+    void finish(std::string_view json) const
+    {
+        if (expected_ != Expected::nothing)
+        {
+            throwUnexpectedEnd(json);
+        }
+    }
+
+private:
+    template<typename Handler>
+    static void consumeInteger(std::string_view lexeme, Handler& handler);
+
+    // Accepts a container that was skipped over, starting at the given token, in place of a value.
+    void skipContainer(std::string_view json, const dansandu::jelly::internal::token::Token& token)
+    {
+        if (expected_ != Expected::value && expected_ != Expected::valueOrArrayEnd)
+        {
+            throwUnexpectedToken(json, token);
+        }
+        valueParsed();
+    }
+
+    void valueParsed()
+    {
+        expected_ = containers_.empty() ? Expected::nothing : containers_.back();
+    }
+
+    // Strips the quotes of a string token. Strings without escape sequences are returned as views into the input and
+    // the others are decoded into a buffer that is reused for the next string.
+    std::string_view decode(std::string_view lexeme)
+    {
+        const auto contents = lexeme.substr(1, lexeme.size() - 2);
+        if (contents.find('\\') == std::string_view::npos)
+        {
+            return contents;
+        }
+        buffer_.clear();
+        dansandu::jelly::internal::escape::unescape(contents, buffer_);
+        return buffer_;
+    }
+
+    std::vector<Expected> containers_;
+    std::string buffer_;
+    Expected expected_ = Expected::value;
+};
+
+template<typename Handler>
+void Parser::consume(const std::string_view json, const dansandu::jelly::internal::token::Token& token,
+                     Handler& handler)
+{
+    const auto lexeme = json.substr(token.begin(), token.end() - token.begin());
+    switch (parseTable[static_cast<int>(expected_)][static_cast<int>(token.getSymbol())])
+    {
+    case Action::skip:
+        break;
+    case Action::null:
+        handler.onNull();
+        valueParsed();
+        break;
+    case Action::trueBoolean:
+        handler.onBool(true);
+        valueParsed();
+        break;
+    case Action::falseBoolean:
+        handler.onBool(false);
+        valueParsed();
+        break;
+    case Action::integer:
+        consumeInteger(lexeme, handler);
+        valueParsed();
+        break;
+    case Action::floatingPoint:
+        handler.onDouble(parseFloatingPoint(lexeme));
+        valueParsed();
+        break;
+    case Action::string:
+        handler.onString(decode(lexeme));
+        valueParsed();
+        break;
+    case Action::startObject:
+        containers_.push_back(Expected::commaOrObjectEnd);
+        handler.onStartObject();
+        expected_ = Expected::keyOrObjectEnd;
+        break;
+    case Action::endObject:
+        containers_.pop_back();
+        handler.onEndObject();
+        valueParsed();
+        break;
+    case Action::startArray:
+        containers_.push_back(Expected::commaOrArrayEnd);
+        handler.onStartArray();
+        expected_ = Expected::valueOrArrayEnd;
+        break;
+    case Action::endArray:
+        containers_.pop_back();
+        handler.onEndArray();
+        valueParsed();
+        break;
+    case Action::key:
+        handler.onKey(decode(lexeme));
+        expected_ = Expected::colon;
+        break;
+    case Action::colon:
+        expected_ = Expected::value;
+        break;
+    case Action::objectComma:
+        expected_ = Expected::key;
+        break;
+    case Action::arrayComma:
+        expected_ = Expected::value;
+        break;
+    default:
+        throwUnexpectedToken(json, token);
+    }
+}
+
+// Integers are reported as signed 64-bit values when they fit, as unsigned 64-bit values when only those can hold them
+// and as floating point numbers otherwise. The conversion reads the lexeme in place and does not depend on the locale.
+template<typename Handler>
+void Parser::consumeInteger(std::string_view lexeme, Handler& handler)
+{
+    if (lexeme.front() == '+')
+    {
+        lexeme.remove_prefix(1);
+    }
+    const auto begin = lexeme.data();
+    const auto end = lexeme.data() + lexeme.size();
+
+    auto integer = std::int64_t{};
+    if (std::from_chars(begin, end, integer).ec == std::errc{})
+    {
+        handler.onInt(integer);
+        return;
+    }
+
+    auto unsignedInteger = std::uint64_t{};
+    if (lexeme.front() != '-' && std::from_chars(begin, end, unsignedInteger).ec == std::errc{})
+    {
+        handler.onUint(unsignedInteger);
+        return;
+    }
+
+    handler.onDouble(parseFloatingPoint(lexeme));
+}
+
+template<typename Handler>
+void Parser::parse(const std::string_view json, Handler& handler, const bool validateUtf8)
+{
+    containers_.clear();
+    expected_ = Expected::value;
+    auto tokenizer = dansandu::jelly::internal::tokenizer::Tokenizer{json, validateUtf8};
+    while (tokenizer.hasNext())
+    {
+        consume(json, tokenizer.next(), handler);
+    }
+    finish(json);
+}
+
+template<typename Handler>
+void Parser::parseSkipping(const std::string_view json, Handler& handler, const bool validateUtf8, const int begin)
+{
+    using dansandu::jelly::internal::token::Symbol;
+
+    containers_.clear();
+    expected_ = Expected::value;
+    auto tokenizer = dansandu::jelly::internal::tokenizer::Tokenizer{json, validateUtf8, begin};
+    while (tokenizer.hasNext())
+    {
+        const auto token = tokenizer.next();
+        const auto symbol = token.getSymbol();
+        if ((symbol == Symbol::arrayBegin || symbol == Symbol::objectBegin) && handler.skips())
+        {
+            skipContainer(json, token);
+            tokenizer.skipContainer();
+            handler.onSkipped(token.begin(), tokenizer.getPosition());
+        }
+        else
+        {
+            consume(json, token, handler);
+        }
+    }
+    finish(json);
+}
+
+template<typename Handler>
+void parse(const std::string_view json, Handler& handler,
+           const dansandu::jelly::options::DeserializationOptions& options = {})
+{
+    auto parser = Parser{};
+    parser.parse(dansandu::jelly::internal::tokenizer::checkInputSize(json, options.maximumSize), handler,
+                 options.validateUtf8);
+}
+
+}
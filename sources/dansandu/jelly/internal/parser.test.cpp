@@ -0,0 +1,154 @@
+#include "dansandu/jelly/internal/parser.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::parser::parse;
+
+class RecordingHandler
+{
+public:
+    void onNull()
+    {
+        events.push_back("null");
+    }
+
+    void onBool(bool value)
+    {
+        events.push_back(value ? "true" : "false");
+    }
+
+    void onInt(std::int64_t value)
+    {
+        events.push_back("int:" + std::to_string(value));
+    }
+
+    void onUint(std::uint64_t value)
+    {
+        events.push_back("uint:" + std::to_string(value));
+    }
+
+    void onDouble(double value)
+    {
+        events.push_back("double:" + std::to_string(value));
+    }
+
+    void onString(std::string_view value)
+    {
+        events.push_back("string:" + std::string{value});
+    }
+
+    void onKey(std::string_view key)
+    {
+        events.push_back("key:" + std::string{key});
+    }
+
+    void onStartObject()
+    {
+        events.push_back("{");
+    }
+
+    void onEndObject()
+    {
+        events.push_back("}");
+    }
+
+    void onStartArray()
+    {
+        events.push_back("[");
+    }
+
+    void onEndArray()
+    {
+        events.push_back("]");
+    }
+
+    std::vector<std::string> events;
+};
+
+TEST_CASE("Parser")
+{
+    auto handler = RecordingHandler{};
+
+    SECTION("primitive")
+    {
+        parse(" -12.5e3 ", handler);
+
+        REQUIRE(handler.events == std::vector<std::string>{"double:-12500.000000"});
+    }
+
+    SECTION("nested")
+    {
+        parse(R"({"a": [1, true, {}], "b": {"c": null, "d": []}, "e": "f"})", handler);
+
+        REQUIRE(handler.events == std::vector<std::string>{"{", "key:a", "[", "int:1", "true", "{", "}", "]", "key:b",
+                                                           "{", "key:c", "null", "key:d", "[", "]", "}", "key:e",
+                                                           "string:f", "}"});
+    }
+
+    SECTION("numbers")
+    {
+        parse("[+7, -9223372036854775808, 9223372036854775808, 18446744073709551616, 0.5]", handler);
+
+        REQUIRE(handler.events ==
+                std::vector<std::string>{"[", "int:7", "int:-9223372036854775808", "uint:9223372036854775808",
+                                         "double:18446744073709551616.000000", "double:0.500000", "]"});
+
+        REQUIRE_THROWS_AS(parse("1e999", handler), JsonDeserializationError);
+    }
+
+    SECTION("numbers out of range")
+    {
+        parse("[1e-400, -1e-400, 1000e-326, 1e-99999999999999999999, 5e-324]", handler);
+
+        REQUIRE(handler.events == std::vector<std::string>{"[", "double:0.000000", "double:-0.000000",
+                                                           "double:0.000000", "double:0.000000", "double:0.000000",
+                                                           "]"});
+
+        REQUIRE_THROWS_AS(parse("-1e999", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("0.000001e315", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("1e99999999999999999999", handler), JsonDeserializationError);
+    }
+
+    SECTION("deeply nested")
+    {
+        const auto depth = 100000;
+        const auto json = std::string(depth, '[') + std::string(depth, ']');
+
+        parse(json, handler);
+
+        REQUIRE(handler.events.size() == 2 * depth);
+    }
+
+    SECTION("syntax errors")
+    {
+        REQUIRE_THROWS_AS(parse("", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("   ", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("[1, 2", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("[1, 2,]", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("[1 2]", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("[1}", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse(R"({"a" 1})", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse(R"({"a": 1,})", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse(R"({1: 1})", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("null null", handler), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parse("nul", handler), JsonDeserializationError);
+    }
+}
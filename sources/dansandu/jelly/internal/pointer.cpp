@@ -0,0 +1,57 @@
+#include "dansandu/jelly/internal/pointer.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace dansandu::jelly::internal::pointer
+{
+
+std::vector<std::string> splitPointer(const std::string_view pointer)
+{
+    if (!pointer.empty() && pointer.front() != '/')
+    {
+        THROW(std::invalid_argument, "json pointer '", pointer, "' must be empty or start with '/'");
+    }
+
+    auto tokens = std::vector<std::string>{};
+    for (auto position = std::size_t{0}; position < pointer.size();)
+    {
+        auto& token = tokens.emplace_back();
+        for (++position; position < pointer.size() && pointer[position] != '/'; ++position)
+        {
+            if (pointer[position] != '~')
+            {
+                token += pointer[position];
+            }
+            else if (position + 1 < pointer.size() && (pointer[position + 1] == '0' || pointer[position + 1] == '1'))
+            {
+                token += pointer[++position] == '0' ? '~' : '/';
+            }
+            else
+            {
+                THROW(std::invalid_argument, "invalid escape sequence at position ", position + 1, " in json pointer '",
+                      pointer, "'");
+            }
+        }
+    }
+    return tokens;
+}
+
+int toIndex(const std::string_view token)
+{
+    if (token.empty() || (token.size() > 1 && token.front() == '0'))
+    {
+        return -1;
+    }
+    auto index = 0;
+    const auto end = token.data() + token.size();
+    const auto [last, error] = std::from_chars(token.data(), end, index);
+    return error == std::errc{} && last == end ? index : -1;
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dansandu::jelly::internal::pointer
+{
+
+// Splits a JSON Pointer (RFC 6901) into its reference tokens and decodes the ~0 and ~1 escapes. The empty pointer
+// refers to the whole document and has no tokens. Throws std::invalid_argument for malformed pointers.
+std::vector<std::string> splitPointer(std::string_view pointer);
+
+// Returns the list index a reference token stands for or -1 if it is not an index. Leading zeros are not allowed.
+int toIndex(std::string_view token);
+
+}
@@ -0,0 +1,55 @@
+#include "dansandu/jelly/internal/pointer.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dansandu::jelly::internal::pointer::splitPointer;
+using dansandu::jelly::internal::pointer::toIndex;
+
+// The pointers are taken from section 5 of RFC 6901.
+TEST_CASE("Pointer")
+{
+    SECTION("split")
+    {
+        REQUIRE(splitPointer("").empty());
+
+        REQUIRE(splitPointer("/") == std::vector<std::string>{""});
+
+        REQUIRE(splitPointer("/foo") == std::vector<std::string>{"foo"});
+
+        REQUIRE(splitPointer("/foo/0") == std::vector<std::string>{"foo", "0"});
+
+        REQUIRE(splitPointer("/a~1b") == std::vector<std::string>{"a/b"});
+
+        REQUIRE(splitPointer("/m~0n") == std::vector<std::string>{"m~n"});
+
+        REQUIRE(splitPointer("/~01") == std::vector<std::string>{"~1"});
+
+        REQUIRE(splitPointer("/c%d/ /") == std::vector<std::string>{"c%d", " ", ""});
+
+        REQUIRE_THROWS_AS(splitPointer("foo"), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(splitPointer("/a~2"), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(splitPointer("/a~"), std::invalid_argument);
+    }
+
+    SECTION("index")
+    {
+        REQUIRE(toIndex("0") == 0);
+
+        REQUIRE(toIndex("125") == 125);
+
+        REQUIRE(toIndex("") == -1);
+
+        REQUIRE(toIndex("01") == -1);
+
+        REQUIRE(toIndex("-1") == -1);
+
+        REQUIRE(toIndex("1a") == -1);
+
+        REQUIRE(toIndex("99999999999") == -1);
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "dansandu/jelly/internal/builder.hpp"
+#include "dansandu/jelly/projection.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dansandu::jelly::internal::projector
+{
+
+// Forwards to the builder only the values selected by the projection and the containers on the way to them. Lists
+// and objects that hold nothing selected are skipped by the parser. Elements left out before a selected one are
+// replaced by nulls so that list indices still refer to the same elements.
+template<typename Json>
+class BasicJsonProjector
+{
+public:
+    BasicJsonProjector(const dansandu::jelly::projection::Projection& projection,
+                       dansandu::jelly::internal::builder::BasicJsonBuilder<Json>& builder)
+        : projection_{projection}, builder_{builder}, member_{-1}, kept_{0}
+    {
+    }
+
+    void onNull()
+    {
+        if (select())
+        {
+            builder_.onNull();
+        }
+    }
+
+    void onBool(bool value)
+    {
+        if (select())
+        {
+            builder_.onBool(value);
+        }
+    }
+
+    void onInt(std::int64_t value)
+    {
+        if (select())
+        {
+            builder_.onInt(value);
+        }
+    }
+
+    void onUint(std::uint64_t value)
+    {
+        if (select())
+        {
+            builder_.onUint(value);
+        }
+    }
+
+    void onDouble(double value)
+    {
+        if (select())
+        {
+            builder_.onDouble(value);
+        }
+    }
+
+    void onString(std::string_view value)
+    {
+        if (select())
+        {
+            builder_.onString(value);
+        }
+    }
+
+    void onKey(std::string_view key)
+    {
+        if (kept_ == 0)
+        {
+            member_ = projection_.getMember(frames_.back().node, key);
+        }
+        if (kept_ > 0 || member_ >= 0)
+        {
+            builder_.onKey(key);
+        }
+    }
+
+    void onStartObject()
+    {
+        start(false);
+        builder_.onStartObject();
+    }
+
+    void onEndObject()
+    {
+        end();
+        builder_.onEndObject();
+    }
+
+    void onStartArray()
+    {
+        start(true);
+        builder_.onStartArray();
+    }
+
+    void onEndArray()
+    {
+        end();
+        builder_.onEndArray();
+    }
+
+    bool skips() const
+    {
+        return kept_ == 0 && next() < 0;
+    }
+
+    void onSkipped(int, int)
+    {
+        advance();
+    }
+
+private:
+    struct Frame
+    {
+        int node;
+        bool list;
+        int index;
+        int size;
+    };
+
+    int next() const
+    {
+        if (frames_.empty())
+        {
+            return dansandu::jelly::projection::Projection::root;
+        }
+        const auto& frame = frames_.back();
+        return frame.list ? projection_.getElement(frame.node, frame.index) : member_;
+    }
+
+    void advance()
+    {
+        if (!frames_.empty() && frames_.back().list)
+        {
+            ++frames_.back().index;
+        }
+    }
+
+    // Pads the list the value that starts belongs to up to the index of the value.
+    void place()
+    {
+        if (!frames_.empty() && frames_.back().list)
+        {
+            auto& frame = frames_.back();
+            for (; frame.size < frame.index; ++frame.size)
+            {
+                builder_.onNull();
+            }
+            ++frame.size;
+        }
+    }
+
+    bool select()
+    {
+        if (kept_ > 0)
+        {
+            return true;
+        }
+        const auto node = next();
+        const auto selected = node >= 0 && projection_.isWhole(node);
+        if (selected)
+        {
+            place();
+        }
+        advance();
+        return selected;
+    }
+
+    void start(const bool list)
+    {
+        if (kept_ > 0)
+        {
+            ++kept_;
+            return;
+        }
+        const auto node = next();
+        place();
+        advance();
+        if (projection_.isWhole(node))
+        {
+            kept_ = 1;
+        }
+        else
+        {
+            frames_.push_back(Frame{node, list, 0, 0});
+        }
+    }
+
+    void end()
+    {
+        if (kept_ > 0)
+        {
+            --kept_;
+        }
+        else
+        {
+            frames_.pop_back();
+        }
+    }
+
+    const dansandu::jelly::projection::Projection& projection_;
+    dansandu::jelly::internal::builder::BasicJsonBuilder<Json>& builder_;
+    std::vector<Frame> frames_;
+    int member_;
+    int kept_;
+};
+
+}
@@ -0,0 +1,211 @@
+#include "dansandu/jelly/internal/scanner.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define JELLY_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(JELLY_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define JELLY_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace dansandu::jelly::internal::scanner
+{
+
+static int countTrailingZeros(std::uint64_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Sets every bit that has an odd number of set bits at or below it, which marks the bytes between an opening quote
+// and its closing quote.
+static std::uint64_t prefixXor(std::uint64_t mask)
+{
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+static void classifyScalar(const char* block, BlockMasks& masks)
+{
+    masks = BlockMasks{0, 0, 0, 0};
+    for (auto i = 0; i < 64; ++i)
+    {
+        const auto c = block[i];
+        const auto bit = std::uint64_t{1} << i;
+        if (c == '"')
+        {
+            masks.quotes |= bit;
+        }
+        else if (c == '\\')
+        {
+            masks.backslashes |= bit;
+        }
+        else if (c == ' ' || ('\t' <= c && c <= '\r'))
+        {
+            masks.whitespace |= bit;
+        }
+        else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':')
+        {
+            masks.structurals |= bit;
+        }
+    }
+}
+
+#ifdef JELLY_SSE2
+
+static void classifySse2(const char* block, BlockMasks& masks)
+{
+    masks = BlockMasks{0, 0, 0, 0};
+    for (auto i = 0; i < 64; i += 16)
+    {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        const auto quotes = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'));
+        const auto backslashes = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'));
+        const auto whitespace =
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                         _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('\t' - 1)),
+                                       _mm_cmplt_epi8(bytes, _mm_set1_epi8('\r' + 1))));
+        // '[' and ']' differ from '{' and '}' only in the 0x20 bit
+        const auto lowered = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        const auto structurals = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(lowered, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lowered, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(',')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(':'))));
+        masks.quotes |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(quotes))} << i;
+        masks.backslashes |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(backslashes))} << i;
+        masks.whitespace |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(whitespace))} << i;
+        masks.structurals |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(structurals))} << i;
+    }
+}
+
+#endif
+
+#ifdef JELLY_AVX2
+
+__attribute__((target("avx2"))) static void classifyAvx2(const char* block, BlockMasks& masks)
+{
+    masks = BlockMasks{0, 0, 0, 0};
+    for (auto i = 0; i < 64; i += 32)
+    {
+        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        const auto quotes = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'));
+        const auto backslashes = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'));
+        const auto whitespace =
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                            _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('\t' - 1)),
+                                             _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), bytes)));
+        const auto lowered = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+        const auto structurals =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('{')),
+                                            _mm256_cmpeq_epi8(lowered, _mm256_set1_epi8('}'))),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(',')),
+                                            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':'))));
+        masks.quotes |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(quotes))} << i;
+        masks.backslashes |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(backslashes))} << i;
+        masks.whitespace |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace))} << i;
+        masks.structurals |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(structurals))} << i;
+    }
+}
+
+#endif
+
+BlockClassifier getScalarClassifier()
+{
+    return classifyScalar;
+}
+
+BlockClassifier getClassifier()
+{
+#ifdef JELLY_AVX2
+    static const auto hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2)
+    {
+        return classifyAvx2;
+    }
+#endif
+#ifdef JELLY_SSE2
+    return classifySse2;
+#else
+    return classifyScalar;
+#endif
+}
+
+int StructuralScanner::next()
+{
+    while (starts_ == 0)
+    {
+        if (scanned_ >= static_cast<int>(string_.size()))
+        {
+            return static_cast<int>(string_.size());
+        }
+        scanBlock();
+    }
+    const auto position = blockBegin_ + countTrailingZeros(starts_);
+    starts_ &= starts_ - 1;
+    return position;
+}
+
+void StructuralScanner::scanBlock()
+{
+    auto masks = BlockMasks{};
+    const auto remaining = static_cast<int>(string_.size()) - scanned_;
+    if (remaining >= 64)
+    {
+        classifier_(string_.data() + scanned_, masks);
+    }
+    else
+    {
+        char padded[64];
+        std::memset(padded, ' ', sizeof(padded));
+        std::memcpy(padded, string_.data() + scanned_, remaining);
+        classifier_(padded, masks);
+    }
+
+    const auto quotes = masks.quotes & ~findEscaped(masks.backslashes);
+    const auto inString = prefixXor(quotes) ^ inString_;
+    inString_ = static_cast<std::uint64_t>(static_cast<std::int64_t>(inString) >> 63);
+
+    const auto scalars = ~(quotes | masks.whitespace | masks.structurals | inString);
+    const auto scalarStarts = scalars & ~((scalars << 1) | previousScalar_);
+    previousScalar_ = scalars >> 63;
+
+    starts_ = (masks.structurals & ~inString) | (quotes & inString) | scalarStarts;
+    blockBegin_ = scanned_;
+    scanned_ += 64;
+}
+
+// Marks the characters that follow an odd run of backslashes. Runs starting on odd bits are told apart from those
+// starting on even bits by adding the run starts to the backslashes, which clears every run and carries past its end.
+std::uint64_t StructuralScanner::findEscaped(std::uint64_t backslashes)
+{
+    constexpr auto evenBits = std::uint64_t{0x5555555555555555};
+
+    backslashes &= ~escaped_;
+    const auto followsEscape = (backslashes << 1) | escaped_;
+    const auto oddSequenceStarts = backslashes & ~evenBits & ~followsEscape;
+    const auto sequencesStartingOnEvenBits = oddSequenceStarts + backslashes;
+    escaped_ = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+    const auto invertMask = sequencesStartingOnEvenBits << 1;
+    return (evenBits ^ invertMask) & followsEscape;
+}
+
+}
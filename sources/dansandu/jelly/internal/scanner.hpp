@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace dansandu::jelly::internal::scanner
+{
+
+struct BlockMasks
+{
+    std::uint64_t quotes;
+    std::uint64_t backslashes;
+    std::uint64_t whitespace;
+    std::uint64_t structurals;
+};
+
+// Classifies the 64 bytes starting at block, one bit per byte.
+using BlockClassifier = void (*)(const char* block, BlockMasks& masks);
+
+BlockClassifier getScalarClassifier();
+
+// Returns the fastest classifier supported by the processor the code is running on.
+BlockClassifier getClassifier();
+
+// Finds where tokens may start by classifying the input 64 bytes at a time: structural characters and opening
+// quotes outside strings and the first character of every run of other non-whitespace characters. Whitespace and the
+// contents of strings are never visited one byte at a time and quotes escaped by a backslash do not end strings.
+// Scanning may start at any position outside a string.
+class StructuralScanner
+{
+public:
+    explicit StructuralScanner(std::string_view string, BlockClassifier classifier = getClassifier(), int begin = 0)
+        : string_{string}, classifier_{classifier}, blockBegin_{begin}, scanned_{begin}, starts_{0}, escaped_{0},
+          inString_{0}, previousScalar_{0}
+    {
+    }
+
+    // Returns the position of the next token start or the size of the string once there are none left.
+    int next();
+
+private:
+    void scanBlock();
+
+    std::uint64_t findEscaped(std::uint64_t backslashes);
+
+    std::string_view string_;
+    BlockClassifier classifier_;
+    int blockBegin_;
+    int scanned_;
+    std::uint64_t starts_;
+    std::uint64_t escaped_;
+    std::uint64_t inString_;
+    std::uint64_t previousScalar_;
+};
+
+}
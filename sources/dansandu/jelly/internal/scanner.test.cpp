@@ -0,0 +1,130 @@
+#include "dansandu/jelly/internal/scanner.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dansandu::jelly::internal::scanner::BlockMasks;
+using dansandu::jelly::internal::scanner::getClassifier;
+using dansandu::jelly::internal::scanner::getScalarClassifier;
+using dansandu::jelly::internal::scanner::StructuralScanner;
+
+static std::vector<int> scanAll(std::string_view string, StructuralScanner scanner)
+{
+    auto starts = std::vector<int>{};
+    for (auto start = scanner.next(); start != static_cast<int>(string.size()); start = scanner.next())
+    {
+        starts.push_back(start);
+    }
+    return starts;
+}
+
+static std::vector<int> scanAllByteByByte(std::string_view string)
+{
+    auto starts = std::vector<int>{};
+    auto inString = false;
+    auto escaped = false;
+    auto previousScalar = false;
+    for (auto i = 0; i < static_cast<int>(string.size()); ++i)
+    {
+        const auto c = string[i];
+        auto scalar = false;
+        if (inString)
+        {
+            inString = escaped || c != '"';
+            escaped = !escaped && c == '\\';
+        }
+        else if (c == '"')
+        {
+            starts.push_back(i);
+            inString = true;
+        }
+        else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':')
+        {
+            starts.push_back(i);
+        }
+        else if (c != ' ' && (c < '\t' || c > '\r'))
+        {
+            scalar = true;
+            if (!previousScalar)
+            {
+                starts.push_back(i);
+            }
+        }
+        previousScalar = scalar;
+    }
+    return starts;
+}
+
+TEST_CASE("StructuralScanner")
+{
+    SECTION("token starts")
+    {
+        const auto string = std::string_view{R"( {"a b": [10, true,null], "{,}" :-0.5e3 })"};
+
+        REQUIRE(scanAll(string, StructuralScanner{string}) ==
+                std::vector<int>{1, 2, 7, 9, 10, 12, 14, 18, 19, 23, 24, 26, 32, 33, 40});
+    }
+
+    SECTION("strings across blocks")
+    {
+        const auto string = std::string(60, ' ') + "[\"" + std::string(100, ',') + "\", 1]";
+
+        REQUIRE(scanAll(string, StructuralScanner{string}) == std::vector<int>{60, 61, 163, 165, 166});
+    }
+
+    SECTION("unterminated string")
+    {
+        const auto string = std::string_view{R"([1, "abc, 2])"};
+
+        REQUIRE(scanAll(string, StructuralScanner{string}) == std::vector<int>{0, 1, 2, 4});
+    }
+
+    SECTION("escaped quotes")
+    {
+        const auto pieces = {R"("a\"b", )", R"("\\", )",      R"("\\\"", )", R"(["\\\\\\\"x\\"], )",
+                             "12, ",        R"("\u0022", )", " "};
+        for (auto offset = 0; offset < 64; ++offset)
+        {
+            auto string = std::string(offset, ' ') + "[";
+            while (string.size() < 300)
+            {
+                for (const auto piece : pieces)
+                {
+                    string += piece;
+                }
+            }
+            string += "0]";
+
+            REQUIRE(scanAll(string, StructuralScanner{string}) == scanAllByteByByte(string));
+
+            REQUIRE(scanAll(string, StructuralScanner{string, getScalarClassifier()}) == scanAllByteByByte(string));
+        }
+    }
+
+    SECTION("classifiers agree")
+    {
+        auto block = std::string(64, ' ');
+        for (auto seed = 0; seed < 256; ++seed)
+        {
+            for (auto i = 0; i < 64; ++i)
+            {
+                block[i] = static_cast<char>((seed * 31 + i * 17 + i * i) % 256);
+            }
+            auto expected = BlockMasks{};
+            auto actual = BlockMasks{};
+
+            getScalarClassifier()(block.data(), expected);
+            getClassifier()(block.data(), actual);
+
+            REQUIRE(actual.quotes == expected.quotes);
+
+            REQUIRE(actual.backslashes == expected.backslashes);
+
+            REQUIRE(actual.whitespace == expected.whitespace);
+
+            REQUIRE(actual.structurals == expected.structurals);
+        }
+    }
+}
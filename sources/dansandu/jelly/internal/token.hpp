@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ostream>
+
+namespace dansandu::jelly::internal::token
+{
+
+// The terminals of the JSON grammar are fixed, so they are plain constants instead of symbols resolved from a grammar
+// at run time. A default constructed symbol stands for no terminal.
+enum class Symbol : unsigned char
+{
+    none,
+    null,
+    trueBoolean,
+    falseBoolean,
+    integer,
+    floatingPoint,
+    string,
+    objectBegin,
+    objectEnd,
+    arrayBegin,
+    arrayEnd,
+    comma,
+    colon,
+    whitespace
+};
+
+constexpr auto symbolCount = static_cast<int>(Symbol::whitespace) + 1;
+
+inline std::ostream& operator<<(std::ostream& stream, const Symbol symbol)
+{
+    return stream << static_cast<int>(symbol);
+}
+
+class Token
+{
+public:
+    constexpr Token(Symbol symbol, int begin, int end) : symbol_{symbol}, begin_{begin}, end_{end}
+    {
+    }
+
+    constexpr Symbol getSymbol() const
+    {
+        return symbol_;
+    }
+
+    constexpr int begin() const
+    {
+        return begin_;
+    }
+
+    constexpr int end() const
+    {
+        return end_;
+    }
+
+private:
+    Symbol symbol_;
+    int begin_;
+    int end_;
+};
+
+constexpr bool operator==(const Token& left, const Token& right)
+{
+    return left.getSymbol() == right.getSymbol() && left.begin() == right.begin() && left.end() == right.end();
+}
+
+constexpr bool operator!=(const Token& left, const Token& right)
+{
+    return !(left == right);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Token& token)
+{
+    return stream << "Token(" << token.getSymbol() << ", " << token.begin() << ", " << token.end() << ")";
+}
+
+}
@@ -1,44 +1,204 @@
 #include "dansandu/jelly/internal/tokenizer.hpp"
 #include "dansandu/ballotin/exception.hpp"
-#include "dansandu/glyph/token.hpp"
 #include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/context.hpp"
 #include "dansandu/jelly/internal/matcher.hpp"
+#include "dansandu/jelly/internal/scanner.hpp"
+#include "dansandu/jelly/internal/token.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
 
-using dansandu::glyph::symbol::Symbol;
-using dansandu::glyph::token::Token;
 using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::context::formatContext;
 using dansandu::jelly::internal::matcher::ExactMatcher;
-using dansandu::jelly::internal::matcher::makeFallbackMatcher;
 using dansandu::jelly::internal::matcher::NumberMatcher;
 using dansandu::jelly::internal::matcher::StringMatcher;
-using dansandu::jelly::internal::matcher::WhitespaceMatcher;
+using dansandu::jelly::internal::scanner::getClassifier;
+using dansandu::jelly::internal::token::Symbol;
+using dansandu::jelly::internal::token::Token;
 
 namespace dansandu::jelly::internal::tokenizer
 {
 
-std::vector<Token> tokenize(std::string_view string, const SymbolPack& symbols)
+enum class TokenClass : unsigned char
 {
-    auto tokens = std::vector<Token>{};
-    auto matcher =
-        makeFallbackMatcher(ExactMatcher{symbols.arrayBegin, "["}, ExactMatcher{symbols.arrayEnd, "]"},
-                            ExactMatcher{symbols.objectBegin, "{"}, ExactMatcher{symbols.objectEnd, "}"},
-                            ExactMatcher{symbols.comma, ","}, ExactMatcher{symbols.colon, ":"},
-                            ExactMatcher{symbols.trueBoolean, "true"}, ExactMatcher{symbols.falseBoolean, "false"},
-                            ExactMatcher{symbols.null, "null"}, NumberMatcher{symbols.integer, symbols.floatingPoint},
-                            StringMatcher{symbols.string}, WhitespaceMatcher{symbols.whitespace});
-    auto position = 0;
-    while (position < static_cast<int>(string.size()))
-    {
-        if (auto match = matcher(string.substr(position)); match.second > 0)
+    unrecognized,
+    arrayBegin,
+    arrayEnd,
+    objectBegin,
+    objectEnd,
+    comma,
+    colon,
+    trueBoolean,
+    falseBoolean,
+    null,
+    number,
+    string
+};
+
+// The first byte of a token is enough to tell which matcher can recognize it, so every token is matched by exactly
+// one matcher regardless of the order the token kinds are listed in.
+static constexpr std::array<TokenClass, 256> makeTokenClasses()
+{
+    auto classes = std::array<TokenClass, 256>{};
+    classes['['] = TokenClass::arrayBegin;
+    classes[']'] = TokenClass::arrayEnd;
+    classes['{'] = TokenClass::objectBegin;
+    classes['}'] = TokenClass::objectEnd;
+    classes[','] = TokenClass::comma;
+    classes[':'] = TokenClass::colon;
+    classes['t'] = TokenClass::trueBoolean;
+    classes['f'] = TokenClass::falseBoolean;
+    classes['n'] = TokenClass::null;
+    classes['"'] = TokenClass::string;
+    classes['+'] = TokenClass::number;
+    classes['-'] = TokenClass::number;
+    for (auto digit = '0'; digit <= '9'; ++digit)
+    {
+        classes[digit] = TokenClass::number;
+    }
+    return classes;
+}
+
+static constexpr auto tokenClasses = makeTokenClasses();
+
+Tokenizer::Tokenizer(std::string_view string, bool validateUtf8, int begin)
+    : string_{checkInputSize(string)},
+      trueMatcher_{Symbol::trueBoolean, "true"},
+      falseMatcher_{Symbol::falseBoolean, "false"},
+      nullMatcher_{Symbol::null, "null"},
+      numberMatcher_{Symbol::integer, Symbol::floatingPoint},
+      stringMatcher_{Symbol::string, validateUtf8},
+      scanner_{string, getClassifier(), begin},
+      position_{begin},
+      nextStart_{scanner_.next()}
+{
+}
+
+std::pair<Symbol, int> Tokenizer::match() const
+{
+    const auto rest = string_.substr(position_);
+    switch (tokenClasses[static_cast<unsigned char>(rest.front())])
+    {
+    case TokenClass::arrayBegin:
+        return {Symbol::arrayBegin, 1};
+    case TokenClass::arrayEnd:
+        return {Symbol::arrayEnd, 1};
+    case TokenClass::objectBegin:
+        return {Symbol::objectBegin, 1};
+    case TokenClass::objectEnd:
+        return {Symbol::objectEnd, 1};
+    case TokenClass::comma:
+        return {Symbol::comma, 1};
+    case TokenClass::colon:
+        return {Symbol::colon, 1};
+    case TokenClass::trueBoolean:
+        return trueMatcher_(rest);
+    case TokenClass::falseBoolean:
+        return falseMatcher_(rest);
+    case TokenClass::null:
+        return nullMatcher_(rest);
+    case TokenClass::number:
+        return numberMatcher_(rest);
+    case TokenClass::string:
+        return stringMatcher_(rest);
+    default:
+        return {Symbol{}, 0};
+    }
+}
+
+// The scanner reports every position where a token may start, so the input up to the next start is either
+// whitespace, which is returned as a single token without matching it byte by byte, or an unrecognized symbol.
+std::optional<Token> Tokenizer::tryNext()
+{
+    if (position_ < nextStart_)
+    {
+        const auto c = string_[position_];
+        if (c != ' ' && (c < '\t' || c > '\r'))
         {
-            tokens.push_back(Token{match.first, position, position + match.second});
-            position += match.second;
+            return std::nullopt;
         }
-        else
+        const auto token = Token{Symbol::whitespace, position_, nextStart_};
+        position_ = nextStart_;
+        return token;
+    }
+
+    if (auto match = this->match(); match.second > 0)
+    {
+        const auto token = Token{match.first, position_, position_ + match.second};
+        position_ += match.second;
+        while (nextStart_ < position_)
         {
-            THROW(JsonDeserializationError, "unrecognized symbol at position ", position + 1, " in input string:\n",
-                  string, "\n", std::string(position, ' '), "^");
+            nextStart_ = scanner_.next();
         }
+        return token;
+    }
+    return std::nullopt;
+}
+
+Token Tokenizer::next()
+{
+    if (auto token = tryNext())
+    {
+        return *token;
+    }
+    THROW(JsonDeserializationError, "unrecognized symbol at position ", position_ + 1, " in input string:\n",
+          formatContext(string_, position_));
+}
+
+void Tokenizer::skipContainer()
+{
+    const auto size = static_cast<int>(string_.size());
+    openObjects_.assign(1, string_[position_ - 1] == '{');
+    while (nextStart_ < size)
+    {
+        const auto start = nextStart_;
+        nextStart_ = scanner_.next();
+        const auto c = string_[start];
+        if (c == '[' || c == '{')
+        {
+            openObjects_.push_back(c == '{');
+        }
+        else if (c == ']' || c == '}')
+        {
+            if (openObjects_.back() != (c == '}'))
+            {
+                THROW(JsonDeserializationError, "mismatched bracket '", c, "' at position ", start + 1,
+                      " in input string:\n", formatContext(string_, start));
+            }
+            openObjects_.pop_back();
+            if (openObjects_.empty())
+            {
+                position_ = start + 1;
+                return;
+            }
+        }
+    }
+    THROW(JsonDeserializationError, "unexpected end of input string:\n", formatContext(string_, size));
+}
+
+std::string_view checkInputSize(const std::string_view string, const std::size_t maximumSize)
+{
+    const auto limit = std::min(maximumSize, static_cast<std::size_t>(std::numeric_limits<int>::max()));
+    if (string.size() > limit)
+    {
+        THROW(JsonDeserializationError, "input string of ", string.size(), " bytes is larger than the maximum of ",
+              limit, " bytes");
+    }
+    return string;
+}
+
+std::vector<Token> tokenize(std::string_view string, bool validateUtf8)
+{
+    auto tokens = std::vector<Token>{};
+    auto tokenizer = Tokenizer{string, validateUtf8};
+    while (tokenizer.hasNext())
+    {
+        tokens.push_back(tokenizer.next());
     }
     return tokens;
 }
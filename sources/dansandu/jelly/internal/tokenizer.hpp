@@ -1,20 +1,64 @@
 #pragma once
 
-#include "dansandu/glyph/symbol.hpp"
-#include "dansandu/glyph/token.hpp"
+#include "dansandu/jelly/internal/matcher.hpp"
+#include "dansandu/jelly/internal/scanner.hpp"
+#include "dansandu/jelly/internal/token.hpp"
 
+#include <cstddef>
+#include <limits>
+#include <optional>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace dansandu::jelly::internal::tokenizer
 {
 
-struct SymbolPack
+class Tokenizer
 {
-    dansandu::glyph::symbol::Symbol null, trueBoolean, falseBoolean, integer, floatingPoint, string, objectBegin,
-        objectEnd, arrayBegin, arrayEnd, comma, colon, whitespace;
+public:
+    // Tokens are read from the given position on.
+    explicit Tokenizer(std::string_view string, bool validateUtf8 = false, int begin = 0);
+
+    bool hasNext() const
+    {
+        return position_ < static_cast<int>(string_.size());
+    }
+
+    int getPosition() const
+    {
+        return position_;
+    }
+
+    std::optional<dansandu::jelly::internal::token::Token> tryNext();
+
+    dansandu::jelly::internal::token::Token next();
+
+    // Moves past the container whose opening bracket was the last token returned. Only the brackets among the token
+    // starts found by the scanner are looked at, so the contents are not matched or validated, but every closing
+    // bracket has to be of the same kind as the opening bracket it closes.
+    void skipContainer();
+
+private:
+    std::pair<dansandu::jelly::internal::token::Symbol, int> match() const;
+
+    std::string_view string_;
+    dansandu::jelly::internal::matcher::ExactMatcher trueMatcher_;
+    dansandu::jelly::internal::matcher::ExactMatcher falseMatcher_;
+    dansandu::jelly::internal::matcher::ExactMatcher nullMatcher_;
+    dansandu::jelly::internal::matcher::NumberMatcher numberMatcher_;
+    dansandu::jelly::internal::matcher::StringMatcher stringMatcher_;
+    dansandu::jelly::internal::scanner::StructuralScanner scanner_;
+    int position_;
+    int nextStart_;
+    std::vector<bool> openObjects_;
 };
 
-std::vector<dansandu::glyph::token::Token> tokenize(std::string_view string, const SymbolPack& symbols);
+// Positions in the input are stored as int, so inputs longer than the largest int are rejected instead of being
+// misparsed, as are inputs longer than the given maximum. Returns the input unchanged otherwise.
+std::string_view checkInputSize(std::string_view string,
+                                std::size_t maximumSize = std::numeric_limits<int>::max());
+
+std::vector<dansandu::jelly::internal::token::Token> tokenize(std::string_view string, bool validateUtf8 = false);
 
 }
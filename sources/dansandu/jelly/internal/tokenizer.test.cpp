@@ -1,13 +1,15 @@
 #include "dansandu/jelly/internal/tokenizer.hpp"
 #include "catchorg/catch/catch.hpp"
-#include "dansandu/glyph/token.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/token.hpp"
 
 #include <vector>
 
-using dansandu::glyph::symbol::Symbol;
-using dansandu::glyph::token::Token;
-using dansandu::jelly::internal::tokenizer::SymbolPack;
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::token::Symbol;
+using dansandu::jelly::internal::token::Token;
 using dansandu::jelly::internal::tokenizer::tokenize;
+using dansandu::jelly::internal::tokenizer::Tokenizer;
 
 // clang-format off
 TEST_CASE("Tokenizer")
@@ -16,40 +18,71 @@ TEST_CASE("Tokenizer")
                       "\"otherString\": [1,2,3],\n"
                       "\"anotherString\": {\"yetAnotherString\":false,\"lastString\":null}";
 
-    const auto symbols = SymbolPack{Symbol{0}, Symbol{1}, Symbol{2}, Symbol{3}, Symbol{4}, Symbol{5}, Symbol{6},
-                                    Symbol{7}, Symbol{8}, Symbol{9}, Symbol{10}, Symbol{11}, Symbol{12}};
-
-    REQUIRE(tokenize(json, symbols) == std::vector<Token>{
-        {symbols.string, 0, 12},
-        {symbols.colon, 12, 13},
-        {symbols.whitespace, 13, 14},
-        {symbols.floatingPoint, 14, 18},
-        {symbols.comma, 18, 19},
-        {symbols.whitespace, 19, 20},
-        {symbols.string, 20, 33},
-        {symbols.colon, 33, 34},
-        {symbols.whitespace, 34, 35},
-        {symbols.arrayBegin, 35, 36},
-        {symbols.integer, 36, 37},
-        {symbols.comma, 37, 38},
-        {symbols.integer, 38, 39},
-        {symbols.comma, 39, 40},
-        {symbols.integer, 40, 41},
-        {symbols.arrayEnd, 41, 42},
-        {symbols.comma, 42, 43},
-        {symbols.whitespace, 43, 44},
-        {symbols.string, 44, 59},
-        {symbols.colon, 59, 60},
-        {symbols.whitespace, 60, 61},
-        {symbols.objectBegin, 61, 62},
-        {symbols.string, 62, 80},
-        {symbols.colon, 80, 81},
-        {symbols.falseBoolean, 81, 86},
-        {symbols.comma, 86, 87},
-        {symbols.string, 87, 99},
-        {symbols.colon, 99, 100},
-        {symbols.null, 100, 104},
-        {symbols.objectEnd, 104, 105}
+    REQUIRE(tokenize(json) == std::vector<Token>{
+        {Symbol::string, 0, 12},
+        {Symbol::colon, 12, 13},
+        {Symbol::whitespace, 13, 14},
+        {Symbol::floatingPoint, 14, 18},
+        {Symbol::comma, 18, 19},
+        {Symbol::whitespace, 19, 20},
+        {Symbol::string, 20, 33},
+        {Symbol::colon, 33, 34},
+        {Symbol::whitespace, 34, 35},
+        {Symbol::arrayBegin, 35, 36},
+        {Symbol::integer, 36, 37},
+        {Symbol::comma, 37, 38},
+        {Symbol::integer, 38, 39},
+        {Symbol::comma, 39, 40},
+        {Symbol::integer, 40, 41},
+        {Symbol::arrayEnd, 41, 42},
+        {Symbol::comma, 42, 43},
+        {Symbol::whitespace, 43, 44},
+        {Symbol::string, 44, 59},
+        {Symbol::colon, 59, 60},
+        {Symbol::whitespace, 60, 61},
+        {Symbol::objectBegin, 61, 62},
+        {Symbol::string, 62, 80},
+        {Symbol::colon, 80, 81},
+        {Symbol::falseBoolean, 81, 86},
+        {Symbol::comma, 86, 87},
+        {Symbol::string, 87, 99},
+        {Symbol::colon, 99, 100},
+        {Symbol::null, 100, 104},
+        {Symbol::objectEnd, 104, 105}
     });
+
+    REQUIRE(tokenize(" -1 \"tr\" true ") == std::vector<Token>{
+        {Symbol::whitespace, 0, 1},
+        {Symbol::integer, 1, 3},
+        {Symbol::whitespace, 3, 4},
+        {Symbol::string, 4, 8},
+        {Symbol::whitespace, 8, 9},
+        {Symbol::trueBoolean, 9, 13},
+        {Symbol::whitespace, 13, 14}
+    });
+
+    REQUIRE_THROWS_AS(tokenize("[1, x]"), JsonDeserializationError);
+
+    REQUIRE_THROWS_AS(tokenize("[1x]"), JsonDeserializationError);
+
+    REQUIRE_THROWS_AS(tokenize("[tru]"), JsonDeserializationError);
+
+    REQUIRE_THROWS_AS(tokenize("[\"open]"), JsonDeserializationError);
+
+    auto tokenizer = Tokenizer{R"([{"a":"]"},[1]], 2)"};
+    tokenizer.next();
+    tokenizer.skipContainer();
+
+    REQUIRE(tokenizer.next() == Token{Symbol::comma, 15, 16});
+
+    auto unterminated = Tokenizer{"[[1]"};
+    unterminated.next();
+
+    REQUIRE_THROWS_AS(unterminated.skipContainer(), JsonDeserializationError);
+
+    auto mismatched = Tokenizer{R"({"y":[1,2},"x":1})"};
+    mismatched.next();
+
+    REQUIRE_THROWS_AS(mismatched.skipContainer(), JsonDeserializationError);
 }
 // clang-format on
@@ -0,0 +1,210 @@
+#include "dansandu/jelly/internal/utf8.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define JELLY_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(JELLY_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define JELLY_SSSE3
+#include <immintrin.h>
+#endif
+
+namespace dansandu::jelly::internal::utf8
+{
+
+static bool validateScalar(std::string_view string)
+{
+    const auto bytes = reinterpret_cast<const unsigned char*>(string.data());
+    const auto size = string.size();
+    auto position = std::size_t{0};
+    while (position < size)
+    {
+        const auto lead = bytes[position];
+        if (lead < 0x80)
+        {
+            ++position;
+            continue;
+        }
+
+        auto length = std::size_t{0};
+        auto lowest = 0x80;
+        auto highest = 0xBF;
+        if (0xC2 <= lead && lead <= 0xDF)
+        {
+            length = 2;
+        }
+        else if (0xE0 <= lead && lead <= 0xEF)
+        {
+            length = 3;
+            lowest = lead == 0xE0 ? 0xA0 : 0x80;
+            highest = lead == 0xED ? 0x9F : 0xBF;
+        }
+        else if (0xF0 <= lead && lead <= 0xF4)
+        {
+            length = 4;
+            lowest = lead == 0xF0 ? 0x90 : 0x80;
+            highest = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (size - position < length || bytes[position + 1] < lowest || bytes[position + 1] > highest)
+        {
+            return false;
+        }
+        for (auto i = std::size_t{2}; i < length; ++i)
+        {
+            if ((bytes[position + i] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        position += length;
+    }
+    return true;
+}
+
+#ifdef JELLY_SSSE3
+
+// Lookup algorithm by Keiser and Lemire: every pair of consecutive bytes is classified with three table lookups on
+// the high nibble of the first byte, its low nibble and the high nibble of the second byte, and the pair is invalid
+// when the three classes share an error bit. Missing third and fourth bytes are found by comparing the continuations
+// that must follow three and four byte leads against those the lookups expected.
+
+constexpr auto tooShort = 1 << 0;
+constexpr auto tooLong = 1 << 1;
+constexpr auto overlong3 = 1 << 2;
+constexpr auto tooLarge = 1 << 3;
+constexpr auto surrogate = 1 << 4;
+constexpr auto overlong2 = 1 << 5;
+constexpr auto tooLarge1000 = 1 << 6;
+constexpr auto overlong4 = 1 << 6;
+constexpr auto twoContinuations = 1 << 7;
+constexpr auto carry = tooShort | tooLong | twoContinuations;
+
+__attribute__((target("ssse3"))) static __m128i highNibbles(__m128i bytes)
+{
+    return _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F));
+}
+
+__attribute__((target("ssse3"))) static __m128i checkBlock(__m128i input, __m128i previousInput)
+{
+    const auto previous1 = _mm_alignr_epi8(input, previousInput, 15);
+
+    const auto byte1High = _mm_shuffle_epi8(
+        _mm_setr_epi8(tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+                      static_cast<char>(twoContinuations), static_cast<char>(twoContinuations),
+                      static_cast<char>(twoContinuations), static_cast<char>(twoContinuations), tooShort | overlong2,
+                      tooShort, tooShort | overlong3 | surrogate, tooShort | tooLarge | tooLarge1000 | overlong4),
+        highNibbles(previous1));
+
+    const auto byte1Low = _mm_shuffle_epi8(
+        _mm_setr_epi8(static_cast<char>(carry | overlong3 | overlong2 | overlong4),
+                      static_cast<char>(carry | overlong2), static_cast<char>(carry), static_cast<char>(carry),
+                      static_cast<char>(carry | tooLarge), static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000 | surrogate),
+                      static_cast<char>(carry | tooLarge | tooLarge1000),
+                      static_cast<char>(carry | tooLarge | tooLarge1000)),
+        _mm_and_si128(previous1, _mm_set1_epi8(0x0F)));
+
+    const auto byte2High = _mm_shuffle_epi8(
+        _mm_setr_epi8(tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                      static_cast<char>(tooLong | overlong2 | twoContinuations | overlong3 | tooLarge1000 | overlong4),
+                      static_cast<char>(tooLong | overlong2 | twoContinuations | overlong3 | tooLarge),
+                      static_cast<char>(tooLong | overlong2 | twoContinuations | surrogate | tooLarge),
+                      static_cast<char>(tooLong | overlong2 | twoContinuations | surrogate | tooLarge), tooShort,
+                      tooShort, tooShort, tooShort),
+        highNibbles(input));
+
+    const auto specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    // only bytes two and three positions after 111_____ and 1111____ leads end up with the high bit set
+    const auto previous2 = _mm_alignr_epi8(input, previousInput, 14);
+    const auto previous3 = _mm_alignr_epi8(input, previousInput, 13);
+    const auto mustBeContinuation =
+        _mm_and_si128(_mm_or_si128(_mm_subs_epu8(previous2, _mm_set1_epi8(0xE0 - 0x80)),
+                                   _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)))),
+                      _mm_set1_epi8(static_cast<char>(0x80)));
+
+    return _mm_xor_si128(mustBeContinuation, specialCases);
+}
+
+__attribute__((target("ssse3"))) static bool validateSsse3(std::string_view string)
+{
+    auto error = _mm_setzero_si128();
+    auto previousInput = _mm_setzero_si128();
+    auto previousAscii = true;
+    auto position = std::size_t{0};
+    while (position < string.size())
+    {
+        auto input = __m128i{};
+        if (string.size() - position >= 16)
+        {
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + position));
+        }
+        else
+        {
+            char padded[16] = {};
+            std::memcpy(padded, string.data() + position, string.size() - position);
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+        }
+
+        // ASCII following ASCII cannot be invalid, so plain text is skipped 16 bytes at a time
+        const auto ascii = _mm_movemask_epi8(input) == 0;
+        if (!ascii || !previousAscii)
+        {
+            error = _mm_or_si128(error, checkBlock(input, previousInput));
+        }
+        previousInput = input;
+        previousAscii = ascii;
+        position += 16;
+    }
+
+    // a sequence cut short by the end of the string is followed by zero padding that is not a continuation
+    if (!previousAscii)
+    {
+        error = _mm_or_si128(error, checkBlock(_mm_setzero_si128(), previousInput));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#endif
+
+Utf8Validator getScalarValidator()
+{
+    return validateScalar;
+}
+
+Utf8Validator getValidator()
+{
+#ifdef JELLY_SSSE3
+    static const auto hasSsse3 = __builtin_cpu_supports("ssse3");
+    if (hasSsse3)
+    {
+        return validateSsse3;
+    }
+#endif
+    return validateScalar;
+}
+
+bool isValidUtf8(std::string_view string)
+{
+    static const auto validator = getValidator();
+    return validator(string);
+}
+
+}
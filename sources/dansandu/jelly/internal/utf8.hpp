@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+namespace dansandu::jelly::internal::utf8
+{
+
+using Utf8Validator = bool (*)(std::string_view string);
+
+Utf8Validator getScalarValidator();
+
+// Returns the fastest validator supported by the processor the code is running on.
+Utf8Validator getValidator();
+
+// Checks that the string is well-formed UTF-8, which rules out overlong encodings, surrogates and code points above
+// U+10FFFF.
+bool isValidUtf8(std::string_view string);
+
+}
@@ -0,0 +1,73 @@
+#include "dansandu/jelly/internal/utf8.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+
+using dansandu::jelly::internal::utf8::getScalarValidator;
+using dansandu::jelly::internal::utf8::getValidator;
+using dansandu::jelly::internal::utf8::isValidUtf8;
+
+TEST_CASE("Utf8")
+{
+    const auto validators = {getScalarValidator(), getValidator()};
+
+    SECTION("valid")
+    {
+        const auto padding = std::string(13, 'a');
+        for (const auto string : {"", "plain ascii", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\x9f\xbf",
+                                  "\xee\x80\x80", "\xf4\x8f\xbf\xbf", "\xc2\x80\xdf\xbf\xe0\xa0\x80\xef\xbf\xbf"})
+        {
+            for (const auto validator : validators)
+            {
+                REQUIRE(validator(string));
+                // moves multibyte sequences across the 16 byte block boundaries
+                REQUIRE(validator(padding + string));
+                REQUIRE(validator(padding + string + padding + string + padding));
+            }
+        }
+    }
+
+    SECTION("invalid")
+    {
+        const auto padding = std::string(14, 'a');
+        for (const auto string : {"\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xc3", "\xc3\x28", "\xe0\x80\x80",
+                                  "\xe0\x9f\xbf", "\xed\xa0\x80", "\xed\xbf\xbf", "\xe2\x82", "\xe2\x28\xac",
+                                  "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xf0\x9f\x98",
+                                  "\xf0\x9f\x98\x80\x80", "\xff", "\xfe"})
+        {
+            for (const auto validator : validators)
+            {
+                REQUIRE(!validator(string));
+                REQUIRE(!validator(padding + string));
+                REQUIRE(!validator(padding + string + padding));
+            }
+        }
+    }
+
+    SECTION("validators agree")
+    {
+        const auto scalar = getScalarValidator();
+        const auto fastest = getValidator();
+        auto generator = std::mt19937{7};
+        auto pieces = std::vector<std::string>{"a", " ", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\x80",
+                                               "\xc3", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe0\x80"};
+        auto pick = std::uniform_int_distribution<std::size_t>{0, pieces.size() - 1};
+        auto valid = 0;
+        for (auto i = 0; i < 2000; ++i)
+        {
+            auto string = std::string{};
+            while (string.size() < 40)
+            {
+                // mostly well-formed pieces so that some of the strings are valid
+                const auto index = pick(generator);
+                string += pieces[index < 5 || i % 2 == 0 ? index % 5 : index];
+            }
+            REQUIRE(scalar(string) == fastest(string));
+            valid += isValidUtf8(string);
+        }
+        REQUIRE(valid > 0);
+        REQUIRE(valid < 2000);
+    }
+}
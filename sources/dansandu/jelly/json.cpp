@@ -1,279 +1,463 @@
 #include "dansandu/jelly/json.hpp"
-#include "dansandu/ballotin/container.hpp"
-#include "dansandu/ballotin/exception.hpp"
 #include "dansandu/ballotin/type_traits.hpp"
-#include "dansandu/glyph/error.hpp"
-#include "dansandu/glyph/node.hpp"
-#include "dansandu/glyph/parser.hpp"
-#include "dansandu/glyph/token.hpp"
-#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/builder.hpp"
+#include "dansandu/jelly/internal/cbor.hpp"
+#include "dansandu/jelly/internal/escape.hpp"
+#include "dansandu/jelly/internal/inline_string.hpp"
+#include "dansandu/jelly/internal/mapping.hpp"
+#include "dansandu/jelly/internal/output.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/internal/projector.hpp"
 #include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/options.hpp"
+#include "dansandu/jelly/projection.hpp"
+#include "dansandu/jelly/sink.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
 #include <iterator>
-#include <map>
-#include <sstream>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <variant>
 #include <vector>
 
-using dansandu::ballotin::container::contains;
-using dansandu::ballotin::container::pop;
-using dansandu::ballotin::container::uniquePushBack;
 using dansandu::ballotin::type_traits::TypePack;
-using dansandu::glyph::error::SyntaxError;
-using dansandu::glyph::error::TokenizationError;
-using dansandu::glyph::node::Node;
-using dansandu::glyph::parser::Parser;
-using dansandu::glyph::symbol::Symbol;
-using dansandu::glyph::token::Token;
-using dansandu::jelly::error::JsonDeserializationError;
-using dansandu::jelly::internal::tokenizer::SymbolPack;
-using dansandu::jelly::internal::tokenizer::tokenize;
+using dansandu::jelly::internal::builder::BasicJsonBuilder;
+using dansandu::jelly::internal::box::unbox;
+using dansandu::jelly::internal::cbor::Decoder;
+using dansandu::jelly::internal::cbor::falseValue;
+using dansandu::jelly::internal::cbor::Major;
+using dansandu::jelly::internal::cbor::nullValue;
+using dansandu::jelly::internal::cbor::trueValue;
+using dansandu::jelly::internal::cbor::writeDouble;
+using dansandu::jelly::internal::cbor::writeHead;
+using dansandu::jelly::internal::cbor::writeInteger;
+using dansandu::jelly::internal::cbor::writeString;
+using dansandu::jelly::internal::escape::escape;
+using dansandu::jelly::internal::inline_string::unbox;
+using dansandu::jelly::internal::mapping::MappedFile;
+using dansandu::jelly::internal::output::ChunkedOutput;
+using dansandu::jelly::internal::parser::parse;
+using dansandu::jelly::internal::parser::Parser;
+using dansandu::jelly::internal::projector::BasicJsonProjector;
+using dansandu::jelly::internal::tokenizer::checkInputSize;
+using dansandu::jelly::options::DeserializationOptions;
+using dansandu::jelly::projection::Projection;
+using dansandu::jelly::sink::Sink;
+using dansandu::jelly::sink::StreamSink;
 
 namespace dansandu::jelly::json
 {
 
-// clang-format off
-static constexpr auto grammar = /* 0*/"Start    -> Value                         \n"
-                                /* 1*/"Object   -> objectBegin Members objectEnd \n"
-                                /* 2*/"Object   -> objectBegin objectEnd         \n"
-                                /* 3*/"Array    -> arrayBegin Elements arrayEnd  \n"
-                                /* 4*/"Array    -> arrayBegin arrayEnd           \n"
-                                /* 5*/"Members  -> Members comma Member          \n"
-                                /* 6*/"Members  -> Member                        \n"
-                                /* 7*/"Member   -> string colon Value            \n"
-                                /* 8*/"Elements -> Elements comma Element        \n"
-                                /* 9*/"Elements -> Element                       \n"
-                                /*10*/"Element  -> Value                         \n"
-                                /*11*/"Value    -> Object                        \n"
-                                /*12*/"Value    -> Array                         \n"
-                                /*13*/"Value    -> string                        \n"
-                                /*14*/"Value    -> integer                       \n"
-                                /*15*/"Value    -> floatingPoint                 \n"
-                                /*16*/"Value    -> true                          \n"
-                                /*17*/"Value    -> false                         \n"
-                                /*18*/"Value    -> null                            ";
-// clang-format on
-
-Json Json::deserialize(const std::string_view json)
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserialize(const std::string_view json, const Allocator& allocator)
 {
-    static const auto parser = Parser{grammar};
-    static const auto symbols =
-        SymbolPack{parser.getTerminalSymbol("null"),          parser.getTerminalSymbol("true"),
-                   parser.getTerminalSymbol("false"),         parser.getTerminalSymbol("integer"),
-                   parser.getTerminalSymbol("floatingPoint"), parser.getTerminalSymbol("string"),
-                   parser.getTerminalSymbol("objectBegin"),   parser.getTerminalSymbol("objectEnd"),
-                   parser.getTerminalSymbol("arrayBegin"),    parser.getTerminalSymbol("arrayEnd"),
-                   parser.getTerminalSymbol("comma"),         parser.getTerminalSymbol("colon"),
-                   parser.getDiscardedSymbolPlaceholder()};
-
-    auto stack = std::vector<Json>{};
-    auto listBeginStack = std::vector<int>{};
-
-    const auto visitor = [&](const Node& node)
+    return deserialize(json, DeserializationOptions{}, allocator);
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserialize(const std::string_view json,
+                                                       const DeserializationOptions& options,
+                                                       const Allocator& allocator)
+{
+    auto builder = BasicJsonBuilder<BasicJson>{allocator, options.internKeys};
+    parse(json, builder, options);
+    return builder.release();
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserialize(const std::string_view json,
+                                                       std::initializer_list<std::string_view> paths,
+                                                       const Allocator& allocator)
+{
+    return deserialize(json, Projection{paths}, DeserializationOptions{}, allocator);
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserialize(const std::string_view json, const Projection& projection,
+                                                       const DeserializationOptions& options,
+                                                       const Allocator& allocator)
+{
+    auto builder = BasicJsonBuilder<BasicJson>{allocator, options.internKeys};
+    auto projector = BasicJsonProjector<BasicJson>{projection, builder};
+    auto parser = Parser{};
+    parser.parseSkipping(checkInputSize(json, options.maximumSize), projector, options.validateUtf8);
+    return builder.release();
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserializeFile(const std::string& path, const Allocator& allocator)
+{
+    return deserializeFile(path, DeserializationOptions{}, allocator);
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::deserializeFile(const std::string& path,
+                                                           const DeserializationOptions& options,
+                                                           const Allocator& allocator)
+{
+    const auto file = MappedFile{path};
+    return deserialize(file.getContents(), options, allocator);
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::fromBinary(const std::string_view binary, const Allocator& allocator)
+{
+    return fromBinary(binary, DeserializationOptions{}, allocator);
+}
+
+template<typename Allocator>
+BasicJson<Allocator> BasicJson<Allocator>::fromBinary(const std::string_view binary,
+                                                      const DeserializationOptions& options,
+                                                      const Allocator& allocator)
+{
+    auto builder = BasicJsonBuilder<BasicJson>{allocator, options.internKeys};
+    auto decoder = Decoder{checkInputSize(binary, options.maximumSize), options.validateUtf8};
+    decoder.decode(builder);
+    return builder.release();
+}
+
+template<typename Allocator>
+std::string BasicJson<Allocator>::serialize() const
+{
+    auto output = std::string{};
+    serialize(output);
+    return output;
+}
+
+template<typename Allocator>
+void BasicJson<Allocator>::serialize(std::string& output) const
+{
+    write(output);
+}
+
+template<typename Allocator>
+void BasicJson<Allocator>::serialize(Sink& sink) const
+{
+    auto output = ChunkedOutput{sink};
+    write(output);
+    output.flush();
+}
+
+template<typename Allocator>
+std::string BasicJson<Allocator>::toBinary() const
+{
+    auto output = std::string{};
+    toBinary(output);
+    return output;
+}
+
+template<typename Allocator>
+void BasicJson<Allocator>::toBinary(std::string& output) const
+{
+    writeBinary(output);
+}
+
+template<typename Allocator>
+void BasicJson<Allocator>::toBinary(Sink& sink) const
+{
+    auto output = ChunkedOutput{sink};
+    writeBinary(output);
+    output.flush();
+}
+
+template<typename Allocator>
+void BasicJson<Allocator>::destroyNested() noexcept
+{
+    // Children are removed from the last one backwards. Before a nested container is descended into, the chain of its
+    // ancestors is moved into the slot it leaves in its parent, so the way back up is kept in the tree itself and
+    // nothing is allocated. Values are only ever moved into nulls and only destroyed once they are leaves or empty.
+    const auto lastChild = [](BasicJson& json) -> BasicJson*
     {
-        if (node.isToken())
+        if (const auto list = json.template getIf<list_type>(); list && !list->empty())
         {
-            const auto& token = node.getToken();
-            const auto symbol = token.getSymbol();
-            if (symbol == symbols.null)
-            {
-                stack.emplace_back(nullptr);
-            }
-            else if (symbol == symbols.trueBoolean)
-            {
-                stack.emplace_back(true);
-            }
-            else if (symbol == symbols.falseBoolean)
-            {
-                stack.emplace_back(false);
-            }
-            else if (symbol == symbols.integer)
-            {
-                const auto string = string_type{json.cbegin() + token.begin(), json.cbegin() + token.end()};
-                stack.emplace_back(std::stoi(string));
-            }
-            else if (symbol == symbols.floatingPoint)
-            {
-                const auto string = string_type{json.cbegin() + token.begin(), json.cbegin() + token.end()};
-                stack.emplace_back(std::stod(string));
-            }
-            else if (symbol == symbols.string)
-            {
-                auto string = string_type{json.cbegin() + token.begin() + 1, json.cbegin() + token.end() - 1};
-                stack.emplace_back(std::move(string));
-            }
-            else if (symbol == symbols.objectBegin)
+            return &list->back();
+        }
+        if (const auto object = json.template getIf<object_type>(); object && !object->empty())
+        {
+            return &(*(object->end() - 1)).second;
+        }
+        return nullptr;
+    };
+    const auto popLastChild = [](BasicJson& json)
+    {
+        if (const auto list = json.template getIf<list_type>())
+        {
+            list->pop_back();
+        }
+        else
+        {
+            json.template getIf<object_type>()->pop_back();
+        }
+    };
+
+    auto ancestors = BasicJson{};
+    auto current = std::move(*this);
+    while (true)
+    {
+        if (const auto child = lastChild(current))
+        {
+            if (child->isNonEmptyContainer())
             {
-                listBeginStack.push_back(static_cast<int>(stack.size()));
+                auto next = std::move(*child);
+                *child = std::move(ancestors);
+                ancestors = std::move(current);
+                current = std::move(next);
             }
-            else if (symbol == symbols.arrayBegin)
+            else
             {
-                listBeginStack.push_back(static_cast<int>(stack.size()));
+                popLastChild(current);
             }
         }
+        else if (!std::holds_alternative<null_type>(ancestors.value_))
+        {
+            current = nullptr;
+            current = std::move(ancestors);
+            ancestors = std::move(*lastChild(current));
+            popLastChild(current);
+        }
         else
         {
-            const auto ruleIndex = node.getRuleIndex();
-            if (ruleIndex == 1 || ruleIndex == 2)
-            {
-                const auto begin = stack.begin() + listBeginStack.back();
-                const auto end = stack.end();
-                listBeginStack.pop_back();
+            break;
+        }
+    }
+}
+
+template<typename Allocator>
+template<typename Output>
+void BasicJson<Allocator>::write(Output& output) const
+{
+    static constexpr const char* boolean[] = {"false", "true"};
+
+    struct Frame
+    {
+        const BasicJson* json;
+        typename list_type::const_iterator element;
+        typename object_type::const_iterator member;
+    };
+
+    auto frames = std::vector<Frame>{};
 
-                auto map = std::map<string_type, Json>{};
-                for (auto position = begin; position != end; ++position)
+    // Primitives are written right away while containers only get their opening bracket and a frame. The loop below
+    // writes the children of the innermost open container and closes it, so the extra memory is one frame per level.
+    const auto write = [&](const BasicJson& json)
+    {
+        std::visit(
+            [&](auto&& stored)
+            {
+                const auto& value = unbox(stored);
+                using type = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<type, bool>)
                 {
-                    auto key = position->get<string_type>();
-                    if (map.find(key) == map.cend())
+                    output += boolean[value];
+                }
+                else if constexpr (TypePack<int, std::int64_t, std::uint64_t>::contains<type>)
+                {
+                    char digits[24];
+                    const auto end = std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+                    output += std::string_view{digits, static_cast<std::size_t>(end - digits)};
+                }
+                else if constexpr (std::is_same_v<type, double>)
+                {
+                    // JSON has no representation for NaN and infinities, so they are written as null like
+                    // JSON.stringify does.
+                    if (!std::isfinite(value))
                     {
-                        ++position;
-                        map.emplace(std::move(key), std::move(*position));
+                        output += "null";
+                        return;
                     }
-                    else
+                    // to_chars writes the shortest digits that parse back to the same double. A fraction is added to
+                    // whole numbers so they are not read back as integers.
+                    char digits[32];
+                    auto end = std::to_chars(std::begin(digits), std::end(digits) - 2, value).ptr;
+                    if (std::all_of(digits, end, [](char c) { return c == '-' || ('0' <= c && c <= '9'); }))
                     {
-                        THROW(JsonDeserializationError, "duplicate key '", key, "' found in Json object");
+                        *end++ = '.';
+                        *end++ = '0';
                     }
+                    output += std::string_view{digits, static_cast<std::size_t>(end - digits)};
+                }
+                else if constexpr (TypePack<string_type, std::string_view>::template contains<type>)
+                {
+                    output += '"';
+                    escape(value, output);
+                    output += '"';
+                }
+                else if constexpr (std::is_same_v<type, null_type>)
+                {
+                    output += "null";
+                }
+                else if constexpr (std::is_same_v<type, list_type>)
+                {
+                    output += '[';
+                    frames.push_back(Frame{&json, value.cbegin(), {}});
+                }
+                else if constexpr (std::is_same_v<type, object_type>)
+                {
+                    output += '{';
+                    frames.push_back(Frame{&json, {}, value.cbegin()});
                 }
-                stack.erase(begin, end);
-                stack.emplace_back(std::move(map));
+            },
+            json.value_);
+    };
+
+    write(*this);
+    while (!frames.empty())
+    {
+        auto& frame = frames.back();
+        if (const auto list = frame.json->template getIf<list_type>())
+        {
+            if (frame.element == list->cend())
+            {
+                output += ']';
+                frames.pop_back();
             }
-            else if (ruleIndex == 3 || ruleIndex == 4)
+            else
             {
-                const auto begin = stack.begin() + listBeginStack.back();
-                const auto end = stack.end();
-                listBeginStack.pop_back();
-
-                auto list = std::vector<Json>{std::make_move_iterator(begin), std::make_move_iterator(end)};
-                stack.erase(begin, end);
-                stack.emplace_back(std::move(list));
+                if (frame.element != list->cbegin())
+                {
+                    output += ',';
+                }
+                const auto& element = *frame.element++;
+                write(element);
+            }
+        }
+        else
+        {
+            const auto& object = *frame.json->template getIf<object_type>();
+            if (frame.member == object.cend())
+            {
+                output += '}';
+                frames.pop_back();
+            }
+            else
+            {
+                if (frame.member != object.cbegin())
+                {
+                    output += ',';
+                }
+                const auto& member = *frame.member++;
+                output += '"';
+                escape(member.first, output);
+                output += "\":";
+                write(member.second);
             }
         }
-    };
-
-    try
-    {
-        const auto tokens = tokenize(json, symbols);
-        parser.parse(tokens, visitor);
-    }
-    catch (const SyntaxError& error)
-    {
-        THROW(JsonDeserializationError, error.what());
     }
-
-    return std::move(stack.back());
 }
 
-std::string Json::serialize() const
+template<typename Allocator>
+template<typename Output>
+void BasicJson<Allocator>::writeBinary(Output& output) const
 {
-    static constexpr const char* boolean[] = {"false", "true"};
-    static constexpr const char* separator[] = {",", ""};
+    struct Frame
+    {
+        const BasicJson* json;
+        typename list_type::const_iterator element;
+        typename object_type::const_iterator member;
+    };
+
+    auto frames = std::vector<Frame>{};
 
-    auto stack = std::vector<const value_type*>{&value_};
-    auto visited = std::vector<const value_type*>{};
-    auto serializedStack = std::vector<std::string>{};
-    auto serializedBeginStack = std::vector<int>{};
-    while (!stack.empty())
+    // Containers are written with their size up front, so closing one only takes popping its frame.
+    const auto write = [&](const BasicJson& json)
     {
         std::visit(
-            [&](auto&& value)
+            [&](auto&& stored)
             {
+                const auto& value = unbox(stored);
                 using type = std::decay_t<decltype(value)>;
                 if constexpr (std::is_same_v<type, bool>)
                 {
-                    serializedStack.push_back(boolean[value]);
-                    stack.pop_back();
+                    output += static_cast<char>(value ? trueValue : falseValue);
+                }
+                else if constexpr (TypePack<int, std::int64_t>::contains<type>)
+                {
+                    writeInteger(output, value);
                 }
-                else if constexpr (TypePack<int, double>::contains<type>)
+                else if constexpr (std::is_same_v<type, std::uint64_t>)
                 {
-                    auto stream = std::stringstream{};
-                    stream << value;
-                    serializedStack.push_back(stream.str());
-                    stack.pop_back();
+                    writeHead(output, Major::unsignedInteger, value);
                 }
-                else if constexpr (std::is_same_v<type, string_type>)
+                else if constexpr (std::is_same_v<type, double>)
                 {
-                    serializedStack.push_back("\"" + value + "\"");
-                    stack.pop_back();
+                    writeDouble(output, value);
+                }
+                else if constexpr (TypePack<string_type, std::string_view>::template contains<type>)
+                {
+                    writeString(output, value);
                 }
                 else if constexpr (std::is_same_v<type, null_type>)
                 {
-                    serializedStack.push_back("null");
-                    stack.pop_back();
+                    output += static_cast<char>(nullValue);
                 }
                 else if constexpr (std::is_same_v<type, list_type>)
                 {
-                    if (!contains(visited, stack.back()))
-                    {
-                        visited.push_back(stack.back());
-                        serializedBeginStack.push_back(static_cast<int>(serializedStack.size()));
-                        for (const auto& element : value)
-                        {
-                            stack.push_back(&element.value_);
-                        }
-                    }
-                    else
-                    {
-                        const auto serializedBegin = pop(serializedBeginStack);
-                        const auto reversedSerializedEnd = static_cast<int>(serializedStack.size()) - serializedBegin;
-                        auto first = true;
-                        auto stream = std::stringstream{};
-                        stream << '[';
-                        for (auto position = serializedStack.crbegin();
-                             position != serializedStack.crbegin() + reversedSerializedEnd; ++position)
-                        {
-                            stream << separator[first] << *position;
-                            first = false;
-                        }
-                        stream << ']';
-                        serializedStack.erase(serializedStack.cbegin() + serializedBegin, serializedStack.cend());
-                        serializedStack.push_back(stream.str());
-                        stack.pop_back();
-                    }
+                    writeHead(output, Major::array, value.size());
+                    frames.push_back(Frame{&json, value.cbegin(), {}});
                 }
                 else if constexpr (std::is_same_v<type, object_type>)
                 {
-                    if (!contains(visited, stack.back()))
-                    {
-                        visited.push_back(stack.back());
-                        serializedBeginStack.push_back(static_cast<int>(serializedStack.size()));
-                        for (const auto& entry : value)
-                        {
-                            stack.push_back(&entry.second.value_);
-                            serializedStack.push_back(entry.first);
-                        }
-                    }
-                    else
-                    {
-                        const auto serializedKeysBegin = pop(serializedBeginStack);
-                        const auto serializedValuesOffset =
-                            (static_cast<int>(serializedStack.size()) - serializedKeysBegin) / 2;
-                        auto first = true;
-                        auto stream = std::stringstream{};
-                        stream << '{';
-                        for (auto i = 0; i < serializedValuesOffset; ++i)
-                        {
-                            stream << separator[first] << "\"" << *(serializedStack.cbegin() + serializedKeysBegin + i)
-                                   << "\":" << *(serializedStack.cend() - i - 1);
-                            first = false;
-                        }
-                        stream << '}';
-                        serializedStack.erase(serializedStack.cbegin() + serializedKeysBegin, serializedStack.cend());
-                        serializedStack.push_back(stream.str());
-                        stack.pop_back();
-                    }
+                    writeHead(output, Major::map, value.size());
+                    frames.push_back(Frame{&json, {}, value.cbegin()});
                 }
             },
-            *stack.back());
+            json.value_);
+    };
+
+    write(*this);
+    while (!frames.empty())
+    {
+        auto& frame = frames.back();
+        if (const auto list = frame.json->template getIf<list_type>())
+        {
+            if (frame.element == list->cend())
+            {
+                frames.pop_back();
+            }
+            else
+            {
+                const auto& element = *frame.element++;
+                write(element);
+            }
+        }
+        else
+        {
+            const auto& object = *frame.json->template getIf<object_type>();
+            if (frame.member == object.cend())
+            {
+                frames.pop_back();
+            }
+            else
+            {
+                const auto& member = *frame.member++;
+                writeString(output, member.first);
+                write(member.second);
+            }
+        }
     }
-    return std::move(serializedStack.back());
 }
 
-std::ostream& operator<<(std::ostream& stream, const Json& json)
+template<typename Allocator>
+std::ostream& operator<<(std::ostream& stream, const BasicJson<Allocator>& json)
 {
-    return stream << json.serialize();
+    auto sink = StreamSink{stream};
+    json.serialize(sink);
+    return stream;
 }
 
+template class BasicJson<std::allocator<char>>;
+
+template std::ostream& operator<<(std::ostream& stream, const Json& json);
+
+template class BasicJson<std::pmr::polymorphic_allocator<char>>;
+
+template std::ostream& operator<<(std::ostream& stream, const pmr::Json& json);
+
 }
@@ -2,148 +2,471 @@
 
 #include "dansandu/ballotin/exception.hpp"
 #include "dansandu/ballotin/type_traits.hpp"
+#include "dansandu/jelly/internal/box.hpp"
+#include "dansandu/jelly/internal/inline_string.hpp"
+#include "dansandu/jelly/object.hpp"
+#include "dansandu/jelly/options.hpp"
+#include "dansandu/jelly/path.hpp"
+#include "dansandu/jelly/projection.hpp"
+#include "dansandu/jelly/sink.hpp"
 
-#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace dansandu::jelly::json
 {
 
-class PRALINE_EXPORT Json
+template<typename Allocator>
+class BasicJson
 {
+    template<typename Type>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
 public:
     using null_type = std::nullptr_t;
-    using string_type = std::string;
-    using list_type = std::vector<Json>;
-    using object_type = std::map<string_type, Json>;
+    using string_type = std::basic_string<char, std::char_traits<char>, Allocator>;
+    using list_type = std::vector<BasicJson, rebind_alloc<BasicJson>>;
+    using object_type = dansandu::jelly::object::FlatObject<BasicJson, Allocator>;
 
 private:
-    using held_types =
-        dansandu::ballotin::type_traits::TypePack<null_type, bool, int, double, string_type, list_type, object_type>;
-    using safe_cast_types = dansandu::ballotin::type_traits::TypePack<bool, int, double, string_type>;
+    using held_types = dansandu::ballotin::type_traits::TypePack<null_type, bool, int, std::int64_t, std::uint64_t,
+                                                                 double, string_type, list_type, object_type>;
+    using safe_cast_types =
+        dansandu::ballotin::type_traits::TypePack<bool, int, std::int64_t, std::uint64_t, double, string_type>;
+
+    using boxed_types = dansandu::ballotin::type_traits::TypePack<string_type, list_type, object_type>;
+
+    template<typename Type>
+    using Box = dansandu::jelly::internal::box::Box<Type>;
+
+    using InlineString = dansandu::jelly::internal::inline_string::InlineString;
 
-    using value_type = typename held_types::VariantType;
+    template<typename Type>
+    using stored_type = std::conditional_t<boxed_types::template contains<Type>, Box<Type>, Type>;
+
+    // Strings and containers are boxed so that every json takes up 16 bytes on 64-bit platforms instead of the size of
+    // the largest alternative. Strings short enough to fit in the place of the box are stored inline instead.
+    using value_type = std::variant<null_type, bool, int, std::int64_t, std::uint64_t, double, InlineString,
+                                    Box<string_type>, Box<list_type>, Box<object_type>>;
+
+    // Strings are read through a std::string_view, since short ones are not stored as a string_type.
+    template<typename Type>
+    using getter_type = std::conditional_t<std::is_same_v<Type, string_type>, std::string_view, const Type&>;
+
+    template<typename Type>
+    using mutable_getter_type = std::conditional_t<std::is_same_v<Type, string_type>, std::string_view, Type&>;
 
 public:
-    static Json deserialize(const std::string_view json);
+    static BasicJson deserialize(const std::string_view json, const Allocator& allocator = Allocator{});
+
+    static BasicJson deserialize(const std::string_view json,
+                                 const dansandu::jelly::options::DeserializationOptions& options,
+                                 const Allocator& allocator = Allocator{});
 
-    static Json object(object_type map)
+    // Deserializes only the values selected by the JSON Pointers, for example {"/orderId", "/items/*/count"}, along
+    // with the lists and objects on the way to them. Everything else is passed over without being stored, and lists
+    // and objects that hold nothing selected are only checked for matching brackets.
+    static BasicJson deserialize(const std::string_view json, std::initializer_list<std::string_view> paths,
+                                 const Allocator& allocator = Allocator{});
+
+    static BasicJson deserialize(const std::string_view json,
+                                 const dansandu::jelly::projection::Projection& projection,
+                                 const dansandu::jelly::options::DeserializationOptions& options = {},
+                                 const Allocator& allocator = Allocator{});
+
+    static BasicJson deserializeFile(const std::string& path, const Allocator& allocator = Allocator{});
+
+    static BasicJson deserializeFile(const std::string& path,
+                                     const dansandu::jelly::options::DeserializationOptions& options,
+                                     const Allocator& allocator = Allocator{});
+
+    // Reads a document encoded with toBinary or any other CBOR encoder, as long as it only uses the JSON data model.
+    static BasicJson fromBinary(const std::string_view binary, const Allocator& allocator = Allocator{});
+
+    static BasicJson fromBinary(const std::string_view binary,
+                                const dansandu::jelly::options::DeserializationOptions& options,
+                                const Allocator& allocator = Allocator{});
+
+    static BasicJson object(object_type members)
     {
-        return Json{std::move(map)};
+        return BasicJson{std::move(members)};
     }
 
-    static Json object()
+    static BasicJson object(const Allocator& allocator = Allocator{})
     {
-        return Json{object_type{}};
+        return BasicJson{object_type(allocator)};
     }
 
-    static Json list(list_type vector)
+    static BasicJson list(list_type vector)
     {
-        return Json{std::move(vector)};
+        return BasicJson{std::move(vector)};
     }
 
-    static Json list(int size)
+    static BasicJson list(int size, const Allocator& allocator = Allocator{})
     {
-        return Json{list_type(size)};
+        return BasicJson{list_type(size, allocator)};
     }
 
-    static Json string(string_type str)
+    static BasicJson string(string_type str)
     {
-        return Json{std::move(str)};
+        return BasicJson{std::move(str)};
     }
 
-    Json() : value_{nullptr}
+    BasicJson() : value_{nullptr}
     {
     }
 
-    template<typename Type, typename = std::enable_if_t<held_types::contains<std::decay_t<Type>>>>
-    explicit Json(Type&& value) : value_{std::forward<Type>(value)}
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<std::decay_t<Type>>>>
+    explicit BasicJson(Type&& value) : value_{store(std::forward<Type>(value))}
     {
     }
 
-    Json(const Json&) = default;
+    BasicJson(const BasicJson&) = default;
+
+    // A json that was moved from holds null.
+    BasicJson(BasicJson&& other) noexcept : value_{std::move(other.value_)}
+    {
+        other.value_ = nullptr;
+    }
 
-    Json(Json&&) noexcept = default;
+    // Nested lists and objects are destroyed without recursion, so dropping a deeply nested json does not overflow
+    // the stack.
+    ~BasicJson()
+    {
+        if (hasNestedContainers())
+        {
+            destroyNested();
+        }
+    }
 
-    template<typename Type, typename = std::enable_if_t<held_types::contains<std::decay_t<Type>>>>
-    Json& operator=(Type&& value)
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<std::decay_t<Type>>>>
+    BasicJson& operator=(Type&& value)
     {
-        value_ = std::forward<Type>(value);
+        value_ = store(std::forward<Type>(value));
         return *this;
     }
 
-    Json& operator=(const Json&) = default;
+    BasicJson& operator=(const BasicJson&) = default;
+
+    BasicJson& operator=(BasicJson&& other) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+    {
+        if (this != &other)
+        {
+            value_ = std::move(other.value_);
+            other.value_ = nullptr;
+        }
+        return *this;
+    }
 
-    Json& operator=(Json&&) noexcept = default;
+    // Strings are returned as a std::string_view, so they are changed by assigning a new string to the json.
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<Type>>>
+    getter_type<Type> get() const&
+    {
+        if constexpr (std::is_same_v<Type, string_type>)
+        {
+            if (const auto string = std::get_if<InlineString>(&value_))
+            {
+                return string->view();
+            }
+        }
+        if (const auto value = getIf<Type>())
+        {
+            return *value;
+        }
+        THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+    }
 
-    template<typename Type, typename = std::enable_if_t<held_types::contains<Type>>>
-    const Type& get() const
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<Type>>>
+    mutable_getter_type<Type> get() &
     {
-        try
+        if constexpr (std::is_same_v<Type, string_type>)
         {
-            return std::get<Type>(value_);
+            return std::as_const(*this).template get<Type>();
         }
-        catch (const std::bad_variant_access&)
+        else if (const auto value = getIf<Type>())
         {
-            THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+            return *value;
         }
+        THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
     }
 
-    template<typename Type, typename = std::enable_if_t<held_types::contains<Type>>>
-    Type& get()
+    // Strings stored inline are returned with a default constructed allocator.
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<Type>>>
+    Type get() &&
     {
-        try
+        if constexpr (std::is_same_v<Type, string_type>)
         {
-            return std::get<Type>(value_);
+            if (const auto string = std::get_if<InlineString>(&value_))
+            {
+                return string_type{string->view()};
+            }
         }
-        catch (const std::bad_variant_access&)
+        if (const auto value = getIf<Type>())
         {
-            THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+            return std::move(*value);
         }
+        THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+    }
+
+    // Moves the value out of the json, which is left holding null.
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<Type>>>
+    Type take()
+    {
+        auto value = std::move(*this).template get<Type>();
+        value_ = nullptr;
+        return value;
     }
 
-    template<typename Type, typename = std::enable_if_t<held_types::contains<Type>>>
+    template<typename Type, typename = std::enable_if_t<held_types::template contains<Type>>>
     bool is() const
     {
-        return std::holds_alternative<Type>(value_);
+        if constexpr (std::is_same_v<Type, string_type>)
+        {
+            if (std::holds_alternative<InlineString>(value_))
+            {
+                return true;
+            }
+        }
+        return std::holds_alternative<stored_type<Type>>(value_);
     }
 
-    const Json& operator[](const int index) const
+    const BasicJson& operator[](const int index) const
     {
         return get<list_type>().at(index);
     }
 
-    Json& operator[](const int index)
+    BasicJson& operator[](const int index)
     {
         return get<list_type>().at(index);
     }
 
-    const Json& operator[](const std::string& key) const
+    const BasicJson& operator[](const std::string_view key) const
     {
         return get<object_type>().at(key);
     }
 
-    Json& operator[](const std::string& key)
+    BasicJson& operator[](const std::string_view key)
     {
         return get<object_type>()[key];
     }
 
+    // Removes the member with the given key from the object and returns its value without copying it.
+    BasicJson extract(const std::string_view key)
+    {
+        auto& object = get<object_type>();
+        const auto member = object.find(key);
+        if (member == object.end())
+        {
+            THROW(std::out_of_range, "key '", key, "' not found in json object");
+        }
+        auto value = std::move(member->second);
+        object.erase(member);
+        return value;
+    }
+
+    // Reserves room for elements in a list or members in an object.
+    void reserve(const int capacity)
+    {
+        if (const auto list = getIf<list_type>())
+        {
+            list->reserve(capacity);
+        }
+        else
+        {
+            get<object_type>().reserve(capacity);
+        }
+    }
+
+    // Appends an element to the list, constructed in place from the arguments.
+    template<typename... Arguments>
+    BasicJson& emplaceBack(Arguments&&... arguments)
+    {
+        return get<list_type>().emplace_back(std::forward<Arguments>(arguments)...);
+    }
+
+    // Adds a member to the object, constructed in place from the arguments, unless the key is already used. Returns
+    // the member with the key either way.
+    template<typename... Arguments>
+    BasicJson& emplace(const std::string_view key, Arguments&&... arguments)
+    {
+        return get<object_type>().try_emplace(key, std::forward<Arguments>(arguments)...).first->second;
+    }
+
+    // Returns the member with the given key or nullptr if there is none or the json does not hold an object.
+    const BasicJson* find(const std::string_view key) const
+    {
+        if (const auto object = getIf<object_type>())
+        {
+            if (const auto member = object->find(key); member != object->end())
+            {
+                return &member->second;
+            }
+        }
+        return nullptr;
+    }
+
+    BasicJson* find(const std::string_view key)
+    {
+        if (const auto object = getIf<object_type>())
+        {
+            if (const auto member = object->find(key); member != object->end())
+            {
+                return &member->second;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns the first value the path matches or nullptr if there is none.
+    const BasicJson* find(const dansandu::jelly::path::Path& path) const
+    {
+        return path.find(*this);
+    }
+
+    BasicJson* find(const dansandu::jelly::path::Path& path)
+    {
+        return path.find(*this);
+    }
+
+    // NaN and infinities are written as null, since JSON cannot represent them.
     std::string serialize() const;
 
+    void serialize(std::string& output) const;
+
+    void serialize(dansandu::jelly::sink::Sink& sink) const;
+
+    // Encodes the json as CBOR (RFC 8949), which is smaller than the text form and does not need number formatting.
+    std::string toBinary() const;
+
+    void toBinary(std::string& output) const;
+
+    void toBinary(dansandu::jelly::sink::Sink& sink) const;
+
+    template<typename Type, typename DecayedType = std::decay_t<Type>,
+             typename = std::enable_if_t<safe_cast_types::template contains<DecayedType>>>
+    operator Type() const&
+    {
+        return DecayedType(get<DecayedType>());
+    }
+
     template<typename Type, typename DecayedType = std::decay_t<Type>,
-             typename = std::enable_if_t<safe_cast_types::contains<DecayedType>>>
-    operator Type() const
+             typename = std::enable_if_t<safe_cast_types::template contains<DecayedType>>>
+    operator Type() &&
     {
-        return get<DecayedType>();
+        return std::move(*this).template get<DecayedType>();
     }
 
 private:
+    template<typename Type>
+    static decltype(auto) store(Type&& value)
+    {
+        if constexpr (std::is_same_v<std::decay_t<Type>, string_type>)
+        {
+            if (InlineString::fits(value))
+            {
+                return value_type{InlineString{value}};
+            }
+            return value_type{Box<string_type>{std::forward<Type>(value)}};
+        }
+        else if constexpr (boxed_types::template contains<std::decay_t<Type>>)
+        {
+            return Box<std::decay_t<Type>>{std::forward<Type>(value)};
+        }
+        else
+        {
+            return std::forward<Type>(value);
+        }
+    }
+
+    template<typename Type>
+    const Type* getIf() const
+    {
+        if constexpr (boxed_types::template contains<Type>)
+        {
+            const auto box = std::get_if<Box<Type>>(&value_);
+            return box ? &box->get() : nullptr;
+        }
+        else
+        {
+            return std::get_if<Type>(&value_);
+        }
+    }
+
+    template<typename Type>
+    Type* getIf()
+    {
+        if constexpr (boxed_types::template contains<Type>)
+        {
+            const auto box = std::get_if<Box<Type>>(&value_);
+            return box ? &box->get() : nullptr;
+        }
+        else
+        {
+            return std::get_if<Type>(&value_);
+        }
+    }
+
+    bool hasNestedContainers() const noexcept
+    {
+        if (const auto list = getIf<list_type>())
+        {
+            return std::any_of(list->cbegin(), list->cend(),
+                               [](const BasicJson& element) { return element.isNonEmptyContainer(); });
+        }
+        if (const auto object = getIf<object_type>())
+        {
+            return std::any_of(object->cbegin(), object->cend(),
+                               [](const auto& member) { return member.second.isNonEmptyContainer(); });
+        }
+        return false;
+    }
+
+    bool isNonEmptyContainer() const noexcept
+    {
+        const auto list = getIf<list_type>();
+        const auto object = getIf<object_type>();
+        return (list && !list->empty()) || (object && !object->empty());
+    }
+
+    void destroyNested() noexcept;
+
+    template<typename Output>
+    void write(Output& output) const;
+
+    template<typename Output>
+    void writeBinary(Output& output) const;
+
     value_type value_;
 };
 
-PRALINE_EXPORT std::ostream& operator<<(std::ostream& stream, const Json& json);
+template<typename Allocator>
+std::ostream& operator<<(std::ostream& stream, const BasicJson<Allocator>& json);
+
+using Json = BasicJson<std::allocator<char>>;
+
+extern template class PRALINE_EXPORT BasicJson<std::allocator<char>>;
+
+extern template PRALINE_EXPORT std::ostream& operator<<(std::ostream& stream, const Json& json);
+
+namespace pmr
+{
+
+using Json = BasicJson<std::pmr::polymorphic_allocator<char>>;
+
+}
+
+extern template class PRALINE_EXPORT BasicJson<std::pmr::polymorphic_allocator<char>>;
+
+extern template PRALINE_EXPORT std::ostream& operator<<(std::ostream& stream, const pmr::Json& json);
 
 }
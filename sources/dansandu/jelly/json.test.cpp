@@ -1,10 +1,53 @@
 #include "dansandu/jelly/json.hpp"
 #include "catchorg/catch/catch.hpp"
 #include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/sink.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using Catch::Detail::Approx;
 using dansandu::jelly::error::JsonDeserializationError;
 using dansandu::jelly::json::Json;
+using dansandu::jelly::options::DeserializationOptions;
+using dansandu::jelly::sink::CallbackSink;
+
+// Counts the allocations and deallocations made through it and forwards them to the default resource.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int allocations = 0;
+    int deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
 
 TEST_CASE("Json")
 {
@@ -53,6 +96,27 @@ TEST_CASE("Json")
             REQUIRE_THROWS_AS(static_cast<double>(json), std::logic_error);
         }
 
+        SECTION("64-bit integers")
+        {
+            const auto string = "[2147483647,4294967296,-9223372036854775808,18446744073709551615]";
+
+            const auto json = Json::deserialize(string);
+
+            REQUIRE(json.serialize() == string);
+
+            REQUIRE(json[0].get<int>() == 2147483647);
+
+            REQUIRE(json[1].get<std::int64_t>() == 4294967296);
+
+            REQUIRE(json[2].get<std::int64_t>() == std::numeric_limits<std::int64_t>::min());
+
+            REQUIRE(json[3].get<std::uint64_t>() == std::numeric_limits<std::uint64_t>::max());
+
+            REQUIRE(Json::deserialize("18446744073709551616").is<double>());
+
+            REQUIRE_THROWS_AS(static_cast<int>(json[1]), std::logic_error);
+        }
+
         SECTION("double")
         {
             const auto string = "0.125";
@@ -66,6 +130,53 @@ TEST_CASE("Json")
             REQUIRE(json.get<double>() == Approx(0.125));
         }
 
+        SECTION("double round trip")
+        {
+            for (const auto value : {0.1, 1.0 / 3.0, -2.5e-300, 5e-324, 1.7976931348623157e308, 123456789.125})
+            {
+                const auto json = Json::deserialize(Json{value}.serialize());
+
+                REQUIRE(json.get<double>() == value);
+            }
+
+            REQUIRE(Json{100.0}.serialize() == "100.0");
+
+            REQUIRE(Json::deserialize(Json{-3.0}.serialize()).get<double>() == -3.0);
+        }
+
+        SECTION("double too close to zero")
+        {
+            REQUIRE(Json::deserialize("1e-400").get<double>() == 0.0);
+
+            REQUIRE(std::signbit(Json::deserialize("-1e-400").get<double>()));
+
+            REQUIRE(Json::deserialize("1e-320").get<double>() > 0.0);
+        }
+
+        SECTION("non-finite double")
+        {
+            const auto json = Json::list(Json::list_type{Json{std::numeric_limits<double>::quiet_NaN()},
+                                                         Json{std::numeric_limits<double>::infinity()},
+                                                         Json{-std::numeric_limits<double>::infinity()}});
+
+            REQUIRE(json.serialize() == "[null,null,null]");
+        }
+
+        SECTION("escaped string")
+        {
+            const auto json = Json::deserialize(R"({"a\"b":"line\nbreak \u00e9 \ud83d\ude00 \\ \/"})");
+
+            REQUIRE(json["a\"b"].get<Json::string_type>() == "line\nbreak \xc3\xa9 \xf0\x9f\x98\x80 \\ /");
+
+            REQUIRE(json.serialize() == "{\"a\\\"b\":\"line\\nbreak \xc3\xa9 \xf0\x9f\x98\x80 \\\\ /\"}");
+
+            REQUIRE(Json{std::string{"\x01\t"}}.serialize() == R"("\u0001\t")");
+
+            REQUIRE_THROWS_AS(Json::deserialize(R"("\x")"), JsonDeserializationError);
+
+            REQUIRE_THROWS_AS(Json::deserialize(R"("\ud83d")"), JsonDeserializationError);
+        }
+
         SECTION("string")
         {
             const auto string = R"("some_value")";
@@ -128,6 +239,42 @@ TEST_CASE("Json")
             REQUIRE_THROWS_AS(json["e"], std::logic_error);
         }
 
+        SECTION("object lookup")
+        {
+            auto json = Json::deserialize(R"({"a":{"b":[1,2]},"c":null})");
+
+            const auto key = std::string_view{"a"};
+
+            REQUIRE(json[key]["b"][1].get<int>() == 2);
+
+            REQUIRE(json[std::string{"c"}].is<Json::null_type>());
+
+            REQUIRE(json.find("a") == &json["a"]);
+
+            REQUIRE(json.find("d") == nullptr);
+
+            REQUIRE(json["a"]["b"].find("b") == nullptr);
+
+            const auto& constant = json;
+
+            REQUIRE(constant.find("c")->is<Json::null_type>());
+
+            REQUIRE(constant.find("d") == nullptr);
+        }
+
+        SECTION("object members keep their order")
+        {
+            const auto string = R"({"zeta":1,"alpha":2,"mu":{"y":null,"x":[]}})";
+
+            auto json = Json::deserialize(string);
+
+            REQUIRE(json.serialize() == string);
+
+            json["beta"] = 3;
+
+            REQUIRE(json.serialize() == R"({"zeta":1,"alpha":2,"mu":{"y":null,"x":[]},"beta":3})");
+        }
+
         SECTION("empty object")
         {
             const auto string = "{}";
@@ -261,6 +408,206 @@ TEST_CASE("Json")
         }
     }
 
+    SECTION("deserialize file")
+    {
+        const auto string = R"({"a":[1,{"b":null}],"c":"d"})";
+        const auto path = (std::filesystem::temp_directory_path() / "jelly_deserialize_file.json").string();
+        std::ofstream{path} << string;
+
+        const auto json = Json::deserializeFile(path);
+
+        REQUIRE(json.serialize() == string);
+
+        std::filesystem::remove(path);
+
+        REQUIRE_THROWS_AS(Json::deserializeFile(path), std::runtime_error);
+    }
+
+    SECTION("deserialize larger than the maximum size")
+    {
+        auto options = DeserializationOptions{};
+        options.maximumSize = 4;
+        const auto path = (std::filesystem::temp_directory_path() / "jelly_deserialize_large_file.json").string();
+        std::ofstream{path} << "[1,2]";
+
+        REQUIRE_THROWS_WITH(Json::deserializeFile(path, options),
+                            Catch::Contains("larger than the maximum of 4 bytes"));
+
+        std::filesystem::remove(path);
+
+        REQUIRE(Json::deserialize("[12]", options).serialize() == "[12]");
+
+        REQUIRE_THROWS_AS(Json::deserialize("[1,2]", options), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::deserialize("[1,2]", dansandu::jelly::projection::Projection{"/0"}, options),
+                          JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::fromBinary(Json::deserialize("[1,2,3,4]").toBinary(), options),
+                          JsonDeserializationError);
+    }
+
+    SECTION("serialize into buffer")
+    {
+        const auto json = Json::deserialize(R"({"a":[1,{"b":null}],"c":"d"})");
+        auto output = std::string{"prefix:"};
+
+        json.serialize(output);
+
+        REQUIRE(output == R"(prefix:{"a":[1,{"b":null}],"c":"d"})");
+    }
+
+    SECTION("serialize into sink")
+    {
+        auto json = Json::list(0);
+        for (auto i = 0; i < 50000; ++i)
+        {
+            json.get<Json::list_type>().push_back(Json{Json::string_type{"element"}});
+        }
+        auto chunks = std::vector<std::string>{};
+        auto sink = CallbackSink{[&](std::string_view chunk) { chunks.emplace_back(chunk); }};
+
+        json.serialize(sink);
+
+        REQUIRE(chunks.size() > 1);
+
+        REQUIRE(std::all_of(chunks.cbegin(), chunks.cend(),
+                            [](const auto& chunk) { return chunk.size() <= 64 * 1024; }));
+
+        REQUIRE(std::accumulate(chunks.cbegin(), chunks.cend(), std::string{}) == json.serialize());
+    }
+
+    SECTION("serialize into stream")
+    {
+        const auto string = R"({"a":[true,false],"b":"c"})";
+        auto stream = std::stringstream{};
+
+        stream << Json::deserialize(string);
+
+        REQUIRE(stream.str() == string);
+    }
+
+    SECTION("serialize deeply nested")
+    {
+        const auto depth = 10000;
+        const auto string = std::string(depth, '[') + std::string(depth, ']');
+
+        const auto json = Json::deserialize(string);
+
+        REQUIRE(json.serialize() == string);
+    }
+
+    SECTION("destroy deeply nested")
+    {
+        const auto depth = 50000;
+        auto string = std::string{};
+        for (auto i = 0; i < depth; ++i)
+        {
+            string += R"({"a":[)";
+        }
+        for (auto i = 0; i < depth; ++i)
+        {
+            string += "]}";
+        }
+
+        auto json = Json::deserialize(string);
+        json = Json::list(0);
+
+        REQUIRE(json.serialize() == "[]");
+
+        auto resource = CountingResource{};
+        auto pmrJson = dansandu::jelly::json::pmr::Json::deserialize(string, &resource);
+        const auto allocations = resource.allocations;
+        pmrJson = dansandu::jelly::json::pmr::Json{};
+
+        REQUIRE(resource.allocations == allocations);
+
+        REQUIRE(resource.deallocations == allocations);
+    }
+
+    SECTION("binary")
+    {
+        const auto string = R"([{"battery":88,"identifier":"f2c4deb09cc1558","lastCharge":1597779221,"list":[],)"
+                            R"("location":[50.5,-10],"samples":{"CO":2,"O2":19},"timestamp":1597780427},)"
+                            R"({"battery":0.1,"identifier":"caf\u00e9 \"quoted\"","lastCharge":null,"map":{},)"
+                            R"("valid":true,"big":18446744073709551615,"small":-9223372036854775808}])";
+        const auto json = Json::deserialize(string);
+
+        const auto binary = json.toBinary();
+
+        REQUIRE(binary.size() < json.serialize().size());
+
+        const auto decoded = Json::fromBinary(binary);
+
+        REQUIRE(decoded.serialize() == json.serialize());
+
+        REQUIRE(decoded[0]["battery"].is<int>());
+
+        REQUIRE(decoded[0]["location"][0].is<double>());
+
+        REQUIRE(decoded[1]["big"].is<std::uint64_t>());
+
+        REQUIRE(decoded[1]["small"].is<std::int64_t>());
+
+        auto nested = Json::list(0);
+        for (auto i = 0; i < 10000; ++i)
+        {
+            auto parent = Json::list(0);
+            parent.emplaceBack(std::move(nested));
+            nested = std::move(parent);
+        }
+
+        REQUIRE(Json::fromBinary(nested.toBinary()).serialize() == nested.serialize());
+
+        auto chunks = std::string{};
+        auto sink = CallbackSink{[&](std::string_view chunk) { chunks += chunk; }};
+        json.toBinary(sink);
+
+        REQUIRE(chunks == binary);
+
+        REQUIRE_THROWS_AS(Json::fromBinary(binary.substr(0, binary.size() - 1)), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::fromBinary("\x62\xc0\xaf", DeserializationOptions{true}), JsonDeserializationError);
+    }
+
+    SECTION("projection")
+    {
+        const auto string = R"({"orderId":"471fc736","items":[{"itemId":"e01d9d5d","count":5,"tags":["a",{"b":[]}]},)"
+                            R"({"itemId":"52cace0f","count":2},{"itemId":"6b1f0e2a"}],"hasPromotion":true,)"
+                            R"("vat":0.20,"customer":{"name":"\"x\"","address":{"city":"y","zip":"z"}}})";
+
+        REQUIRE(Json::deserialize(string, {"/orderId", "/items/*/count"}).serialize() ==
+                R"({"orderId":"471fc736","items":[{"count":5},{"count":2},{}]})");
+
+        const auto sparse =
+            Json::deserialize(string, {"/items/1/itemId", "/customer/address/city", "/vat", "/missing"});
+
+        REQUIRE(sparse.serialize() ==
+                R"({"items":[null,{"itemId":"52cace0f"}],"vat":0.2,"customer":{"address":{"city":"y"}}})");
+
+        REQUIRE(Json::deserialize(string, {"/customer", "/customer/name"}).serialize() ==
+                R"({"customer":{"name":"\"x\"","address":{"city":"y","zip":"z"}}})");
+
+        REQUIRE(Json::deserialize(string, {"/orderId/0", "/items/itemId"}).serialize() == R"({"items":[]})");
+
+        REQUIRE(Json::deserialize(string, {""}).serialize() == Json::deserialize(string).serialize());
+
+        REQUIRE(Json::deserialize("[[1,2],[3,4]]", {"/*/1"}).serialize() == "[[null,2],[null,4]]");
+
+        REQUIRE(Json::deserialize("7", {"/a"}).is<Json::null_type>());
+
+        const auto projection = dansandu::jelly::projection::Projection{"/a"};
+
+        REQUIRE(Json::deserialize(R"({"a":1,"b":[1 2]})", projection).serialize() == R"({"a":1})");
+
+        REQUIRE_THROWS_AS(Json::deserialize(R"({"y":[1,2},"x":1})", {"/x"}), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::deserialize(R"({"a":1,"b":[1,2})", projection), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::deserialize(R"({"a":1,"a":2})", projection), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::deserialize(R"({"a":1 "b":{}})", projection), JsonDeserializationError);
+    }
+
     SECTION("bad json")
     {
         REQUIRE_THROWS_AS(Json::deserialize(R"({"badColonMember"; [1, 2, 3]})"), JsonDeserializationError);
@@ -271,6 +618,172 @@ TEST_CASE("Json")
                           JsonDeserializationError);
     }
 
+    SECTION("UTF-8 validation")
+    {
+        const auto options = DeserializationOptions{true};
+
+        REQUIRE(Json::deserialize("[\"caf\xc3\xa9\"]", options)[0].get<Json::string_type>() == "caf\xc3\xa9");
+
+        REQUIRE(Json::deserialize("[\"\xc0\xaf\"]")[0].get<Json::string_type>() == "\xc0\xaf");
+
+        REQUIRE_THROWS_AS(Json::deserialize("[\"\xc0\xaf\"]", options), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Json::deserialize("{\"\xed\xa0\x80\": 1}", options), JsonDeserializationError);
+    }
+
+    SECTION("compact layout")
+    {
+        REQUIRE(sizeof(Json) <= 16);
+
+        REQUIRE(sizeof(dansandu::jelly::json::pmr::Json) <= 16);
+
+        auto list = Json::deserialize(R"([{"key":"a string that does not fit in a small string"},[1,2],"text"])");
+        const auto copy = list;
+        auto moved = std::move(list);
+
+        REQUIRE(list.is<Json::null_type>());
+
+        REQUIRE(moved.serialize() == copy.serialize());
+
+        moved[0] = std::move(moved[1]);
+
+        REQUIRE(moved[1].is<Json::null_type>());
+
+        REQUIRE(moved.serialize() == R"([[1,2],null,"text"])");
+
+        moved[2] = copy[0]["key"];
+
+        REQUIRE(moved[2].get<Json::string_type>() == "a string that does not fit in a small string");
+
+        REQUIRE(copy.serialize() == R"([{"key":"a string that does not fit in a small string"},[1,2],"text"])");
+    }
+
+    SECTION("inline strings")
+    {
+        using PmrJson = dansandu::jelly::json::pmr::Json;
+
+        auto numbersResource = CountingResource{};
+        const auto numbers = PmrJson::deserialize("[0,0,0,[0]]", &numbersResource);
+        auto resource = CountingResource{};
+        auto list = PmrJson::deserialize(R"(["","short","a\"b\u00e9",["seven!!"]])", &resource);
+
+        REQUIRE(resource.allocations == numbersResource.allocations);
+
+        REQUIRE(list[0].is<PmrJson::string_type>());
+
+        REQUIRE(list[0].get<PmrJson::string_type>().empty());
+
+        REQUIRE(list[1].get<PmrJson::string_type>() == "short");
+
+        REQUIRE(list[2].get<PmrJson::string_type>() == "a\"b\xc3\xa9");
+
+        REQUIRE(list.serialize() == "[\"\",\"short\",\"a\\\"b\xc3\xa9\",[\"seven!!\"]]");
+
+        REQUIRE(PmrJson::fromBinary(list.toBinary()).serialize() == list.serialize());
+
+        auto json = Json::deserialize(R"(["short","eight!!!"])");
+        const auto copy = json;
+
+        REQUIRE(static_cast<Json::string_type>(copy[0]) == "short");
+
+        REQUIRE(json[0].take<Json::string_type>() == "short");
+
+        REQUIRE(json[0].is<Json::null_type>());
+
+        json[0] = Json::string_type{"a string that does not fit in a small string"};
+        json[1] = Json::string_type{"tiny"};
+
+        REQUIRE(json.serialize() == R"(["a string that does not fit in a small string","tiny"])");
+
+        REQUIRE(copy.serialize() == R"(["short","eight!!!"])");
+
+        REQUIRE_THROWS_AS(json[1].get<int>(), std::logic_error);
+
+        REQUIRE_THROWS_AS(Json{1}.get<Json::string_type>(), std::logic_error);
+    }
+
+    SECTION("move out")
+    {
+        auto json = Json::deserialize(R"({"text":"a string that does not fit in a small string","list":[1,2,3]})");
+        const auto text = json["text"].get<Json::string_type>().data();
+        const auto list = json["list"].get<Json::list_type>().data();
+
+        const auto movedText = std::move(json["text"]).get<Json::string_type>();
+
+        REQUIRE(movedText.data() == text);
+
+        const auto takenList = json["list"].take<Json::list_type>();
+
+        REQUIRE(takenList.data() == list);
+
+        REQUIRE(json["list"].is<Json::null_type>());
+
+        REQUIRE_THROWS_AS(json["list"].take<Json::list_type>(), std::logic_error);
+
+        const std::string converted = Json::deserialize(R"("converted")");
+
+        REQUIRE(converted == "converted");
+    }
+
+    SECTION("extract")
+    {
+        auto json = Json::deserialize(R"({"a":[1,2],"b":true})");
+        const auto elements = json["a"].get<Json::list_type>().data();
+
+        auto extracted = json.extract("a");
+
+        REQUIRE(extracted.get<Json::list_type>().data() == elements);
+
+        REQUIRE(json.serialize() == R"({"b":true})");
+
+        REQUIRE_THROWS_AS(json.extract("a"), std::out_of_range);
+    }
+
+    SECTION("reserve and emplace")
+    {
+        auto json = Json::object();
+        json.reserve(2);
+        json.emplace("list", Json::list(0));
+        json.emplace("count", 1);
+
+        REQUIRE(json.emplace("count", 2).get<int>() == 1);
+
+        auto& list = json["list"];
+        list.reserve(3);
+        list.emplaceBack(1);
+        list.emplaceBack(Json::string("two"));
+        list.emplaceBack();
+
+        REQUIRE(list.get<Json::list_type>().capacity() >= 3);
+
+        REQUIRE(json.serialize() == R"({"list":[1,"two",null],"count":1})");
+    }
+
+    SECTION("interned keys")
+    {
+        const auto string = R"({"items":[{"itemId":"a","count":5},{"itemId":"b","count":2},{"itemId":"c"},)"
+                            R"({"count":1,"itemId":"d"},{"itemId":"e","count":3}],"total":{"count":11}})";
+
+        auto options = DeserializationOptions{};
+        options.internKeys = true;
+
+        auto json = Json::deserialize(string, options);
+
+        REQUIRE(json.serialize() == string);
+
+        REQUIRE(json["items"][4]["count"].get<int>() == 3);
+
+        REQUIRE(json["items"][2].find("count") == nullptr);
+
+        json["items"][0]["price"] = 10.5;
+        json["items"][1].get<Json::object_type>().erase("itemId");
+
+        REQUIRE(json.serialize() == R"({"items":[{"itemId":"a","count":5,"price":10.5},{"count":2},{"itemId":"c"},)"
+                                    R"({"count":1,"itemId":"d"},{"itemId":"e","count":3}],"total":{"count":11}})");
+
+        REQUIRE_THROWS_AS(Json::deserialize(R"([{"a":1,"b":2},{"a":1,"a":2}])", options), JsonDeserializationError);
+    }
+
     SECTION("README example")
     {
         const auto order = Json::deserialize(R"({
@@ -0,0 +1,541 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::jelly::object
+{
+
+// Object that keeps its members in insertion order. The values are stored in a contiguous array and the keys in a
+// separate shape, which objects with the same keys in the same order can share. A shared shape is copied before it is
+// changed. Shapes with more than indexThreshold keys also keep an open addressing hash table of key positions and
+// smaller ones are searched linearly. Lookups take any string convertible to std::string_view and never allocate.
+//
+// Iterators dereference to pairs of references to the key and the value, so members are iterated with const auto& or
+// auto&& and keys cannot be modified through them.
+template<typename Value, typename Allocator>
+class FlatObject
+{
+    template<typename Type>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+    template<bool Constant>
+    class Iterator;
+
+public:
+    using key_type = std::basic_string<char, std::char_traits<char>, rebind_alloc<char>>;
+    using mapped_type = Value;
+    using value_type = std::pair<key_type, mapped_type>;
+    using reference = std::pair<const key_type&, mapped_type&>;
+    using const_reference = std::pair<const key_type&, const mapped_type&>;
+    using size_type = std::size_t;
+    using allocator_type = rebind_alloc<mapped_type>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static constexpr size_type indexThreshold = 8;
+
+    FlatObject() = default;
+
+    explicit FlatObject(const allocator_type& allocator) : values_(allocator)
+    {
+    }
+
+    FlatObject(const FlatObject& other)
+        : values_{other.values_}, shape_{other.shareShape(values_.get_allocator())}
+    {
+    }
+
+    FlatObject(FlatObject&&) noexcept = default;
+
+    FlatObject(const FlatObject& other, const allocator_type& allocator)
+        : values_(other.values_, allocator), shape_{other.shareShape(allocator)}
+    {
+    }
+
+    FlatObject(FlatObject&& other, const allocator_type& allocator) : values_(allocator)
+    {
+        *this = std::move(other);
+    }
+
+    FlatObject& operator=(const FlatObject& other)
+    {
+        if (this != &other)
+        {
+            values_ = other.values_;
+            shape_ = other.shareShape(values_.get_allocator());
+        }
+        return *this;
+    }
+
+    FlatObject& operator=(FlatObject&& other)
+    {
+        if (this != &other)
+        {
+            // the shape is taken first because moving values between unequal allocators empties the other object
+            auto shape = other.shareShape(values_.get_allocator());
+            values_ = std::move(other.values_);
+            shape_ = std::move(shape);
+            other.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return values_.get_allocator();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{keys(), values_.data()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{keys(), values_.data()};
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return begin() + size();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + size();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return values_.size();
+    }
+
+    void reserve(size_type capacity)
+    {
+        values_.reserve(capacity);
+    }
+
+    void clear() noexcept
+    {
+        values_.clear();
+        shape_.reset();
+    }
+
+    iterator find(std::string_view key)
+    {
+        return begin() + locate(key);
+    }
+
+    const_iterator find(std::string_view key) const
+    {
+        return begin() + locate(key);
+    }
+
+    size_type count(std::string_view key) const
+    {
+        return locate(key) != size();
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return locate(key) != size();
+    }
+
+    mapped_type& at(std::string_view key)
+    {
+        return values_[locateExisting(key)];
+    }
+
+    const mapped_type& at(std::string_view key) const
+    {
+        return values_[locateExisting(key)];
+    }
+
+    mapped_type& operator[](std::string_view key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    mapped_type& operator[](const char* key)
+    {
+        return try_emplace(std::string_view{key}).first->second;
+    }
+
+    // The key is only copied when the member is inserted and the shape does not already hold it.
+    template<typename... Arguments>
+    std::pair<iterator, bool> try_emplace(std::string_view key, Arguments&&... arguments)
+    {
+        return insertMember(key, std::forward<Arguments>(arguments)...);
+    }
+
+    template<typename... Arguments>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Arguments&&... arguments)
+    {
+        return insertMember(std::move(key), std::forward<Arguments>(arguments)...);
+    }
+
+    template<typename... Arguments>
+    std::pair<iterator, bool> try_emplace(const char* key, Arguments&&... arguments)
+    {
+        return insertMember(std::string_view{key}, std::forward<Arguments>(arguments)...);
+    }
+
+    template<typename... Arguments>
+    std::pair<iterator, bool> emplace(Arguments&&... arguments)
+    {
+        auto member = value_type(std::forward<Arguments>(arguments)...);
+        return insertMember(std::move(member.first), std::move(member.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& member)
+    {
+        return insertMember(std::string_view{member.first}, member.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& member)
+    {
+        return insertMember(std::move(member.first), std::move(member.second));
+    }
+
+    iterator erase(const_iterator position)
+    {
+        const auto offset = static_cast<size_type>(position - cbegin());
+        ownShape();
+        shape_->keys.erase(shape_->keys.begin() + offset);
+        values_.erase(values_.begin() + offset);
+        rebuildIndex(*shape_);
+        return begin() + offset;
+    }
+
+    // Removes the last member. The shape is left as it is, since it may hold more keys than the object has members,
+    // so this never allocates.
+    void pop_back() noexcept
+    {
+        values_.pop_back();
+    }
+
+    size_type erase(std::string_view key)
+    {
+        if (const auto position = locate(key); position != size())
+        {
+            erase(cbegin() + position);
+            return 1;
+        }
+        return 0;
+    }
+
+    // Lets this empty object share the keys of the model, so members inserted with the same keys in the same order
+    // do not store their own copy of the keys. Has no effect if the allocators are not equal.
+    void shareKeys(const FlatObject& model)
+    {
+        if (empty() && get_allocator() == model.get_allocator())
+        {
+            shape_ = model.shape_;
+        }
+    }
+
+private:
+    struct Shape
+    {
+        explicit Shape(const Allocator& allocator) : keys(allocator), index(allocator)
+        {
+        }
+
+        std::vector<key_type, rebind_alloc<key_type>> keys;
+        std::vector<std::uint32_t, rebind_alloc<std::uint32_t>> index;
+    };
+
+    template<bool Constant>
+    class Iterator
+    {
+        using value_pointer = std::conditional_t<Constant, const mapped_type*, mapped_type*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename FlatObject::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Constant, typename FlatObject::const_reference,
+                                             typename FlatObject::reference>;
+
+        struct pointer
+        {
+            const reference* operator->() const
+            {
+                return &member;
+            }
+
+            reference member;
+        };
+
+        Iterator() = default;
+
+        Iterator(const key_type* key, value_pointer value) : key_{key}, value_{value}
+        {
+        }
+
+        template<bool OtherConstant, typename = std::enable_if_t<Constant && !OtherConstant>>
+        Iterator(const Iterator<OtherConstant>& other) : key_{other.key_}, value_{other.value_}
+        {
+        }
+
+        reference operator*() const
+        {
+            return reference{*key_, *value_};
+        }
+
+        pointer operator->() const
+        {
+            return pointer{**this};
+        }
+
+        Iterator& operator++()
+        {
+            ++key_;
+            ++value_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        Iterator& operator--()
+        {
+            --key_;
+            --value_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        Iterator operator+(difference_type offset) const
+        {
+            return Iterator{key_ + offset, value_ + offset};
+        }
+
+        Iterator operator-(difference_type offset) const
+        {
+            return Iterator{key_ - offset, value_ - offset};
+        }
+
+        difference_type operator-(const Iterator& other) const
+        {
+            return value_ - other.value_;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return value_ == other.value_;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return value_ != other.value_;
+        }
+
+    private:
+        friend class Iterator<!Constant>;
+
+        const key_type* key_ = nullptr;
+        value_pointer value_ = nullptr;
+    };
+
+    static std::size_t hash(std::string_view key)
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    const key_type* keys() const noexcept
+    {
+        return shape_ ? shape_->keys.data() : nullptr;
+    }
+
+    // Returns the position of the member with the key or size() if there is none. A shared shape may hold more keys
+    // than the object has members, so positions past the members are ignored.
+    size_type locate(std::string_view key) const
+    {
+        if (!shape_)
+        {
+            return size();
+        }
+
+        const auto& keys = shape_->keys;
+        const auto& index = shape_->index;
+        if (index.empty())
+        {
+            for (auto position = size_type{0}; position < size(); ++position)
+            {
+                if (keys[position] == key)
+                {
+                    return position;
+                }
+            }
+            return size();
+        }
+
+        const auto mask = index.size() - 1;
+        for (auto slot = hash(key) & mask; index[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const auto position = size_type{index[slot] - 1};
+            if (keys[position] == key)
+            {
+                return position < size() ? position : size();
+            }
+        }
+        return size();
+    }
+
+    size_type locateExisting(std::string_view key) const
+    {
+        if (const auto position = locate(key); position != size())
+        {
+            return position;
+        }
+        THROW(std::out_of_range, "key '", key, "' not found in json object");
+    }
+
+    // The keys of a shape are unique, so a member with the next key of the shape cannot be a duplicate and is added
+    // without a lookup or a copy of its key.
+    template<typename Key, typename... Arguments>
+    std::pair<iterator, bool> insertMember(Key&& key, Arguments&&... arguments)
+    {
+        const auto position = size();
+        if (!shape_ || position == shape_->keys.size() || shape_->keys[position] != key)
+        {
+            if (const auto existing = locate(key); existing != position)
+            {
+                return {begin() + existing, false};
+            }
+            ownShape();
+            shape_->keys.emplace_back(std::forward<Key>(key));
+            indexLast(*shape_);
+        }
+        values_.emplace_back(std::forward<Arguments>(arguments)...);
+        return {begin() + position, true};
+    }
+
+    // Makes the shape hold exactly the keys of the members and not be shared with other objects.
+    void ownShape()
+    {
+        if (!shape_ || shape_.use_count() > 1)
+        {
+            shape_ = copyShape(values_.get_allocator());
+        }
+        else if (shape_->keys.size() > size())
+        {
+            shape_->keys.erase(shape_->keys.begin() + size(), shape_->keys.end());
+            rebuildIndex(*shape_);
+        }
+    }
+
+    std::shared_ptr<Shape> copyShape(const Allocator& allocator) const
+    {
+        auto shape = std::allocate_shared<Shape>(rebind_alloc<Shape>(allocator), allocator);
+        if (shape_)
+        {
+            shape->keys.assign(shape_->keys.cbegin(), shape_->keys.cbegin() + size());
+            rebuildIndex(*shape);
+        }
+        return shape;
+    }
+
+    // Shapes are only shared between objects with equal allocators, so a shape never outlives the memory it is in.
+    std::shared_ptr<Shape> shareShape(const allocator_type& allocator) const
+    {
+        if (!shape_ || allocator == get_allocator())
+        {
+            return shape_;
+        }
+        return copyShape(allocator);
+    }
+
+    static void insertIntoIndex(Shape& shape, size_type position)
+    {
+        const auto mask = shape.index.size() - 1;
+        auto slot = hash(shape.keys[position]) & mask;
+        while (shape.index[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        shape.index[slot] = static_cast<std::uint32_t>(position + 1);
+    }
+
+    // The table is kept at most half full.
+    static void indexLast(Shape& shape)
+    {
+        const auto size = shape.keys.size();
+        if (shape.index.empty() ? size > indexThreshold : 2 * size > shape.index.size())
+        {
+            rebuildIndex(shape);
+        }
+        else if (!shape.index.empty())
+        {
+            insertIntoIndex(shape, size - 1);
+        }
+    }
+
+    static void rebuildIndex(Shape& shape)
+    {
+        const auto size = shape.keys.size();
+        shape.index.clear();
+        if (size <= indexThreshold)
+        {
+            return;
+        }
+        auto capacity = size_type{32};
+        while (capacity < 4 * size)
+        {
+            capacity *= 2;
+        }
+        shape.index.resize(capacity);
+        for (auto position = size_type{0}; position < size; ++position)
+        {
+            insertIntoIndex(shape, position);
+        }
+    }
+
+    std::vector<mapped_type, allocator_type> values_;
+    std::shared_ptr<Shape> shape_;
+};
+
+}
@@ -0,0 +1,232 @@
+#include "dansandu/jelly/object.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dansandu::jelly::object::FlatObject;
+
+using Object = FlatObject<int, std::allocator<char>>;
+
+static std::vector<std::string> getKeys(const Object& object)
+{
+    auto keys = std::vector<std::string>{};
+    for (const auto& member : object)
+    {
+        keys.push_back(member.first);
+    }
+    return keys;
+}
+
+TEST_CASE("FlatObject")
+{
+    auto object = Object{};
+
+    SECTION("members keep insertion order")
+    {
+        object["b"] = 1;
+        object["a"] = 2;
+        object.emplace("c", 3);
+        object.try_emplace("a", 4);
+
+        REQUIRE(getKeys(object) == std::vector<std::string>{"b", "a", "c"});
+
+        REQUIRE(object.at("a") == 2);
+
+        REQUIRE(object.at(std::string_view{"b"}) == 1);
+
+        REQUIRE(object.contains(std::string{"c"}));
+
+        REQUIRE(object.count("c") == 1);
+
+        REQUIRE(object.count("d") == 0);
+
+        REQUIRE(object.find("d") == object.end());
+
+        REQUIRE_THROWS_AS(object.at("d"), std::out_of_range);
+    }
+
+    SECTION("duplicate keys are rejected")
+    {
+        REQUIRE(object.emplace("key", 1).second);
+
+        const auto [position, inserted] = object.emplace("key", 2);
+
+        REQUIRE(!inserted);
+
+        REQUIRE(position->second == 1);
+
+        REQUIRE(!object.try_emplace("key", 3).second);
+
+        REQUIRE(object.size() == 1);
+    }
+
+    SECTION("lookup below and above the index threshold")
+    {
+        const auto count = 1000;
+        for (auto i = 0; i < count; ++i)
+        {
+            REQUIRE(object.try_emplace("key" + std::to_string(i), i).second);
+
+            REQUIRE(object.at("key" + std::to_string(i / 2)) == i / 2);
+
+            REQUIRE(object.count("missing") == 0);
+
+            REQUIRE(!object.emplace("key" + std::to_string(i), -1).second);
+        }
+
+        REQUIRE(object.size() == count);
+
+        auto expected = 0;
+        for (const auto& member : object)
+        {
+            REQUIRE(member.second == expected++);
+        }
+    }
+
+    SECTION("shared keys")
+    {
+        object["a"] = 1;
+        object["b"] = 2;
+        object["c"] = 3;
+
+        auto same = Object{};
+        same.shareKeys(object);
+        same["a"] = 4;
+        same["b"] = 5;
+        same["c"] = 6;
+
+        auto prefix = Object{};
+        prefix.shareKeys(object);
+        prefix["a"] = 7;
+        prefix["b"] = 8;
+
+        auto different = Object{};
+        different.shareKeys(object);
+        different["a"] = 9;
+        different["x"] = 10;
+
+        REQUIRE(&same.begin()->first == &object.begin()->first);
+
+        REQUIRE(&prefix.begin()->first == &object.begin()->first);
+
+        REQUIRE(getKeys(same) == std::vector<std::string>{"a", "b", "c"});
+
+        REQUIRE(getKeys(prefix) == std::vector<std::string>{"a", "b"});
+
+        REQUIRE(getKeys(different) == std::vector<std::string>{"a", "x"});
+
+        REQUIRE(prefix.count("c") == 0);
+
+        REQUIRE(prefix.try_emplace("d", 11).second);
+
+        same.erase("a");
+
+        REQUIRE(getKeys(object) == std::vector<std::string>{"a", "b", "c"});
+
+        REQUIRE(getKeys(same) == std::vector<std::string>{"b", "c"});
+
+        REQUIRE(getKeys(prefix) == std::vector<std::string>{"a", "b", "d"});
+
+        REQUIRE(object.at("a") == 1);
+
+        REQUIRE(same.at("c") == 6);
+
+        auto copy = object;
+        copy["z"] = 12;
+
+        REQUIRE(object.count("z") == 0);
+
+        REQUIRE(getKeys(copy) == std::vector<std::string>{"a", "b", "c", "z"});
+    }
+
+    SECTION("shared keys with an index")
+    {
+        for (auto i = 0; i < 20; ++i)
+        {
+            object["key" + std::to_string(i)] = i;
+        }
+
+        auto prefix = Object{};
+        prefix.shareKeys(object);
+        for (auto i = 0; i < 10; ++i)
+        {
+            prefix["key" + std::to_string(i)] = -i;
+        }
+
+        REQUIRE(prefix.size() == 10);
+
+        REQUIRE(prefix.at("key9") == -9);
+
+        REQUIRE(prefix.count("key15") == 0);
+
+        REQUIRE(prefix.find("key15") == prefix.end());
+
+        REQUIRE(object.at("key15") == 15);
+    }
+
+    SECTION("objects with unequal allocators do not share keys")
+    {
+        auto first = std::pmr::monotonic_buffer_resource{};
+        auto second = std::pmr::monotonic_buffer_resource{};
+        using PmrObject = FlatObject<int, std::pmr::polymorphic_allocator<char>>;
+
+        auto original = PmrObject{PmrObject::allocator_type{&first}};
+        original["a long key that does not fit in a small string"] = 1;
+
+        auto copy = PmrObject{PmrObject::allocator_type{&second}};
+        copy = original;
+
+        REQUIRE(copy.begin()->first.get_allocator().resource() == &second);
+
+        REQUIRE(copy.at("a long key that does not fit in a small string") == 1);
+
+        auto moved = PmrObject{PmrObject::allocator_type{&second}};
+        moved = std::move(original);
+
+        REQUIRE(moved.begin()->first.get_allocator().resource() == &second);
+
+        REQUIRE(moved.at("a long key that does not fit in a small string") == 1);
+    }
+
+    SECTION("erase")
+    {
+        for (auto i = 0; i < 20; ++i)
+        {
+            object["key" + std::to_string(i)] = i;
+        }
+
+        REQUIRE(object.erase("key3") == 1);
+
+        REQUIRE(object.erase("key3") == 0);
+
+        for (auto i = 4; i < 20; ++i)
+        {
+            object.erase(object.find("key" + std::to_string(i)));
+        }
+
+        REQUIRE(getKeys(object) == std::vector<std::string>{"key0", "key1", "key2"});
+
+        REQUIRE(object.at("key2") == 2);
+
+        object.pop_back();
+
+        REQUIRE(getKeys(object) == std::vector<std::string>{"key0", "key1"});
+
+        REQUIRE(object.count("key2") == 0);
+
+        object["key2"] = 20;
+
+        REQUIRE(object.at("key2") == 20);
+
+        object.clear();
+
+        REQUIRE(object.empty());
+
+        REQUIRE(object.count("key0") == 0);
+    }
+}
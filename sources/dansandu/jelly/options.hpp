@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace dansandu::jelly::options
+{
+
+struct DeserializationOptions
+{
+    // Rejects documents with strings that are not valid UTF-8. Everything outside strings is ASCII in valid JSON, so
+    // the strings are the only input that has to be checked.
+    bool validateUtf8 = false;
+
+    // Lets objects share the keys of the previous object at the same depth when they have the same keys in the same
+    // order, which is the case for the elements of most arrays of objects. Each key is then stored once per distinct
+    // set of keys instead of once per object.
+    bool internKeys = false;
+
+    // Rejects whole documents longer than this many bytes before parsing them. Documents longer than the largest int
+    // are always rejected, since positions in the input are stored as int. Chunks fed to the incremental parser are
+    // not counted.
+    std::size_t maximumSize = std::numeric_limits<int>::max();
+};
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "dansandu/jelly/internal/builder.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/json.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace dansandu::jelly::parser
+{
+
+// Deserializes one document after another while keeping the memory of its working buffers, so parsing a small message
+// allocates nothing besides the nodes of the result. When keys are interned, objects keep sharing keys with the
+// objects of the previous documents. A parser is meant to be owned by a single thread.
+template<typename Json>
+class BasicJsonParser
+{
+public:
+    using allocator_type = typename Json::string_type::allocator_type;
+
+    explicit BasicJsonParser(const dansandu::jelly::options::DeserializationOptions& options = {},
+                             const allocator_type& allocator = allocator_type{})
+        : builder_{allocator, options.internKeys},
+          maximumSize_{options.maximumSize},
+          validateUtf8_{options.validateUtf8}
+    {
+    }
+
+    Json parse(const std::string_view json)
+    {
+        builder_.clear();
+        parser_.parse(dansandu::jelly::internal::tokenizer::checkInputSize(json, maximumSize_), builder_,
+                      validateUtf8_);
+        return builder_.release();
+    }
+
+private:
+    dansandu::jelly::internal::parser::Parser parser_;
+    dansandu::jelly::internal::builder::BasicJsonBuilder<Json> builder_;
+    std::size_t maximumSize_;
+    bool validateUtf8_;
+};
+
+using JsonParser = BasicJsonParser<dansandu::jelly::json::Json>;
+
+namespace pmr
+{
+
+using JsonParser = BasicJsonParser<dansandu::jelly::json::pmr::Json>;
+
+}
+
+}
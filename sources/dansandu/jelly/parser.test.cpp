@@ -0,0 +1,64 @@
+#include "dansandu/jelly/parser.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <memory_resource>
+#include <string>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::json::Json;
+using dansandu::jelly::options::DeserializationOptions;
+using dansandu::jelly::parser::JsonParser;
+
+TEST_CASE("JsonParser")
+{
+    SECTION("parse several documents")
+    {
+        auto parser = JsonParser{};
+        for (auto i = 0; i < 100; ++i)
+        {
+            const auto string = R"({"id":)" + std::to_string(i) + R"(,"values":[[],{"a":"\"b\""},null,)" +
+                                std::to_string(i) + ".5]}";
+
+            REQUIRE(parser.parse(string).serialize() == string);
+        }
+    }
+
+    SECTION("reuse after an invalid document")
+    {
+        auto parser = JsonParser{};
+
+        REQUIRE_THROWS_AS(parser.parse(R"({"a":[1,2)"), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(parser.parse(R"({"a":1,"a":2})"), JsonDeserializationError);
+
+        REQUIRE(parser.parse("[true]").serialize() == "[true]");
+
+        REQUIRE(parser.parse("7").get<int>() == 7);
+    }
+
+    SECTION("options")
+    {
+        auto parser = JsonParser{DeserializationOptions{true, true}};
+
+        REQUIRE_THROWS_AS(parser.parse("[\"\xc0\xaf\"]"), JsonDeserializationError);
+
+        const auto first = parser.parse(R"({"key":1,"other":2})");
+        const auto second = parser.parse(R"({"key":3,"other":4})");
+
+        REQUIRE(&first.get<Json::object_type>().begin()->first == &second.get<Json::object_type>().begin()->first);
+
+        REQUIRE(second.serialize() == R"({"key":3,"other":4})");
+    }
+
+    SECTION("allocator")
+    {
+        auto resource = std::pmr::monotonic_buffer_resource{};
+        auto parser = dansandu::jelly::parser::pmr::JsonParser{{}, &resource};
+
+        auto json = parser.parse(R"(["a string that does not fit in a small string"])");
+
+        REQUIRE(json[0].take<dansandu::jelly::json::pmr::Json::string_type>().get_allocator().resource() == &resource);
+    }
+}
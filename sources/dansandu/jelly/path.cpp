@@ -0,0 +1,64 @@
+#include "dansandu/jelly/path.hpp"
+#include "dansandu/jelly/internal/pointer.hpp"
+
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+using dansandu::jelly::internal::pointer::splitPointer;
+using dansandu::jelly::internal::pointer::toIndex;
+
+namespace dansandu::jelly::path
+{
+
+// Reads a bound of a range, which is empty or an integer that may be negative.
+static std::optional<int> toBound(const std::string_view token, const int fallback)
+{
+    if (token.empty())
+    {
+        return fallback;
+    }
+    auto bound = 0;
+    const auto end = token.data() + token.size();
+    const auto [last, error] = std::from_chars(token.data(), end, bound);
+    if (error != std::errc{} || last != end)
+    {
+        return std::nullopt;
+    }
+    return bound;
+}
+
+Path::Path(const std::string_view pointer) : query_{false}
+{
+    for (auto& token : splitPointer(pointer))
+    {
+        auto step = Step{Kind::member, std::move(token), -1, 0, 0};
+        if (step.name == "*")
+        {
+            step.kind = Kind::wildcard;
+        }
+        else if (const auto colon = step.name.find(':'); colon != std::string::npos)
+        {
+            const auto name = std::string_view{step.name};
+            const auto begin = toBound(name.substr(0, colon), 0);
+            const auto end = toBound(name.substr(colon + 1), std::numeric_limits<int>::max());
+            if (begin && end)
+            {
+                step.kind = Kind::slice;
+                step.begin = *begin;
+                step.end = *end;
+            }
+        }
+        else
+        {
+            step.index = toIndex(step.name);
+        }
+        query_ = query_ || step.kind != Kind::member;
+        steps_.push_back(std::move(step));
+    }
+}
+
+}
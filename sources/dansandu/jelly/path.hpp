@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dansandu::jelly::path
+{
+
+// Compiled JSON Pointer (RFC 6901) that is parsed once and evaluated against any number of documents. Besides member
+// names and list indices, a path may use a * token, which matches every member or element, and a start:end token,
+// which matches the list elements in the half-open range. Either bound of a range may be left out and negative bounds
+// count from the end of the list. On objects both kinds of tokens match members with the same name. Results are
+// pointers into the document, so nothing is copied.
+class PRALINE_EXPORT Path
+{
+public:
+    explicit Path(std::string_view pointer);
+
+    // Tells whether the path can match more than one value.
+    bool isQuery() const
+    {
+        return query_;
+    }
+
+    // Returns the first value the path matches or nullptr if there is none.
+    template<typename Json>
+    Json* find(Json& json) const
+    {
+        auto result = static_cast<Json*>(nullptr);
+        walk(json, 0,
+             [&result](Json& value)
+             {
+                 result = &value;
+                 return false;
+             });
+        return result;
+    }
+
+    // Calls the visitor with every value the path matches, in document order.
+    template<typename Json, typename Visitor>
+    void forEach(Json& json, Visitor&& visitor) const
+    {
+        walk(json, 0,
+             [&visitor](Json& value)
+             {
+                 visitor(value);
+                 return true;
+             });
+    }
+
+    template<typename Json>
+    std::vector<Json*> select(Json& json) const
+    {
+        auto results = std::vector<Json*>{};
+        forEach(json, [&results](Json& value) { results.push_back(&value); });
+        return results;
+    }
+
+private:
+    enum class Kind
+    {
+        member,
+        wildcard,
+        slice
+    };
+
+    struct Step
+    {
+        Kind kind;
+        std::string name;
+        int index;
+        int begin;
+        int end;
+    };
+
+    // Visits the values matched by the steps from the given position on and stops as soon as the visitor returns
+    // false, in which case false is returned.
+    template<typename Json, typename Visitor>
+    bool walk(Json& json, std::size_t position, const Visitor& visitor) const;
+
+    std::vector<Step> steps_;
+    bool query_;
+};
+
+template<typename Json, typename Visitor>
+bool Path::walk(Json& json, const std::size_t position, const Visitor& visitor) const
+{
+    using value_type = std::remove_const_t<Json>;
+    using list_type = typename value_type::list_type;
+    using object_type = typename value_type::object_type;
+
+    if (position == steps_.size())
+    {
+        return visitor(json);
+    }
+
+    const auto& step = steps_[position];
+    if (json.template is<object_type>())
+    {
+        if (step.kind == Kind::wildcard)
+        {
+            for (auto&& member : json.template get<object_type>())
+            {
+                if (!walk(member.second, position + 1, visitor))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        const auto member = json.find(step.name);
+        return member == nullptr || walk(*member, position + 1, visitor);
+    }
+
+    if (json.template is<list_type>())
+    {
+        auto& list = json.template get<list_type>();
+        const auto size = static_cast<int>(list.size());
+        if (step.kind == Kind::member)
+        {
+            return step.index < 0 || step.index >= size || walk(list[step.index], position + 1, visitor);
+        }
+
+        auto begin = 0;
+        auto end = size;
+        if (step.kind == Kind::slice)
+        {
+            begin = step.begin < 0 ? std::max(size + step.begin, 0) : std::min(step.begin, size);
+            end = step.end < 0 ? std::max(size + step.end, 0) : std::min(step.end, size);
+        }
+        for (auto index = begin; index < end; ++index)
+        {
+            if (!walk(list[index], position + 1, visitor))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,123 @@
+#include "dansandu/jelly/path.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/json.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dansandu::jelly::json::Json;
+using dansandu::jelly::path::Path;
+
+TEST_CASE("Path")
+{
+    SECTION("pointers")
+    {
+        const auto json = Json::deserialize(R"({"foo": ["bar", "baz"], "": 0, "a/b": 1, "c%d": 2, "e^f": 3, "g|h": 4,
+                                                "i\\j": 5, "k\"l": 6, " ": 7, "m~n": 8})");
+
+        REQUIRE(Path{""}.find(json) == &json);
+
+        REQUIRE(json.find(Path{"/foo"}) == &json["foo"]);
+
+        REQUIRE(json.find(Path{"/foo/0"})->get<std::string>() == "bar");
+
+        REQUIRE(json.find(Path{"/"})->get<int>() == 0);
+
+        REQUIRE(json.find(Path{"/a~1b"})->get<int>() == 1);
+
+        REQUIRE(json.find(Path{"/c%d"})->get<int>() == 2);
+
+        REQUIRE(json.find(Path{"/e^f"})->get<int>() == 3);
+
+        REQUIRE(json.find(Path{"/g|h"})->get<int>() == 4);
+
+        REQUIRE(json.find(Path{"/i\\j"})->get<int>() == 5);
+
+        REQUIRE(json.find(Path{"/k\"l"})->get<int>() == 6);
+
+        REQUIRE(json.find(Path{"/ "})->get<int>() == 7);
+
+        REQUIRE(json.find(Path{"/m~0n"})->get<int>() == 8);
+
+        REQUIRE(!Path{"/foo/1"}.isQuery());
+    }
+
+    SECTION("missing values")
+    {
+        const auto json = Json::deserialize(R"({"foo": ["bar", "baz"], "number": 1})");
+
+        REQUIRE(json.find(Path{"/bar"}) == nullptr);
+
+        REQUIRE(json.find(Path{"/foo/2"}) == nullptr);
+
+        REQUIRE(json.find(Path{"/foo/-"}) == nullptr);
+
+        REQUIRE(json.find(Path{"/foo/01"}) == nullptr);
+
+        REQUIRE(json.find(Path{"/number/0"}) == nullptr);
+    }
+
+    SECTION("modification")
+    {
+        auto json = Json::deserialize(R"({"items": [{"count": 1}, {"count": 2}]})");
+        const auto path = Path{"/items/1/count"};
+
+        *json.find(path) = 5;
+
+        REQUIRE(json.serialize() == R"({"items":[{"count":1},{"count":5}]})");
+    }
+
+    SECTION("wildcard")
+    {
+        auto json =
+            Json::deserialize(R"({"items": [{"count": 1}, {"count": 2}, {"price": 3}], "total": {"a": 4, "b": 5}})");
+
+        const auto counts = Path{"/items/*/count"}.select(json);
+
+        REQUIRE(Path{"/items/*/count"}.isQuery());
+
+        REQUIRE(counts == std::vector<Json*>{&json["items"][0]["count"], &json["items"][1]["count"]});
+
+        auto sum = 0;
+        Path{"/total/*"}.forEach(json, [&sum](const Json& value) { sum += value.get<int>(); });
+
+        REQUIRE(sum == 9);
+
+        REQUIRE(json.find(Path{"/items/*/price"}) == &json["items"][2]["price"]);
+    }
+
+    SECTION("slice")
+    {
+        const auto json = Json::deserialize(R"({"list": [0, 1, 2, 3, 4], "1:2": "member"})");
+        const auto values = [&json](const std::string& pointer)
+        {
+            auto result = std::vector<int>{};
+            Path{pointer}.forEach(json, [&result](const Json& value) { result.push_back(value.get<int>()); });
+            return result;
+        };
+
+        REQUIRE(values("/list/1:3") == std::vector<int>{1, 2});
+
+        REQUIRE(values("/list/:2") == std::vector<int>{0, 1});
+
+        REQUIRE(values("/list/3:") == std::vector<int>{3, 4});
+
+        REQUIRE(values("/list/-2:") == std::vector<int>{3, 4});
+
+        REQUIRE(values("/list/:-3") == std::vector<int>{0, 1});
+
+        REQUIRE(values("/list/2:10") == std::vector<int>{2, 3, 4});
+
+        REQUIRE(values("/list/3:1").empty());
+
+        REQUIRE(json.find(Path{"/1:2"})->get<std::string>() == "member");
+    }
+
+    SECTION("invalid pointer")
+    {
+        REQUIRE_THROWS_AS(Path{"foo"}, std::invalid_argument);
+
+        REQUIRE_THROWS_AS(Path{"/foo~2"}, std::invalid_argument);
+    }
+}
@@ -0,0 +1,114 @@
+#include "dansandu/jelly/projection.hpp"
+#include "dansandu/jelly/internal/pointer.hpp"
+
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dansandu::jelly::internal::pointer::splitPointer;
+
+namespace dansandu::jelly::projection
+{
+
+int Projection::getMember(const int node, const std::string_view key) const
+{
+    for (const auto& [name, child] : nodes_[node].members)
+    {
+        if (name == key)
+        {
+            return child;
+        }
+    }
+    return nodes_[node].wildcard;
+}
+
+int Projection::getElement(const int node, const int index) const
+{
+    if (nodes_[node].members.empty())
+    {
+        return nodes_[node].wildcard;
+    }
+    char digits[16];
+    const auto end = std::to_chars(std::begin(digits), std::end(digits), index).ptr;
+    return getMember(node, std::string_view{digits, static_cast<std::size_t>(end - digits)});
+}
+
+void Projection::add(const std::string_view path)
+{
+    add(root, splitPointer(path), 0);
+}
+
+// Members that are named explicitly also get every path added under the wildcard, so a value only ever has to follow
+// one node.
+void Projection::add(const int node, const std::vector<std::string>& tokens, const std::size_t position)
+{
+    if (nodes_[node].whole)
+    {
+        return;
+    }
+    if (position == tokens.size())
+    {
+        nodes_[node].whole = true;
+        return;
+    }
+
+    const auto& token = tokens[position];
+    if (token == "*")
+    {
+        if (nodes_[node].wildcard < 0)
+        {
+            nodes_.emplace_back();
+            nodes_[node].wildcard = static_cast<int>(nodes_.size()) - 1;
+        }
+        add(nodes_[node].wildcard, tokens, position + 1);
+        for (auto member = std::size_t{0}; member < nodes_[node].members.size(); ++member)
+        {
+            add(nodes_[node].members[member].second, tokens, position + 1);
+        }
+        return;
+    }
+
+    auto child = -1;
+    for (const auto& [name, index] : nodes_[node].members)
+    {
+        if (name == token)
+        {
+            child = index;
+        }
+    }
+    if (child < 0)
+    {
+        if (nodes_[node].wildcard >= 0)
+        {
+            child = copy(nodes_[node].wildcard);
+        }
+        else
+        {
+            nodes_.emplace_back();
+            child = static_cast<int>(nodes_.size()) - 1;
+        }
+        nodes_[node].members.emplace_back(token, child);
+    }
+    add(child, tokens, position + 1);
+}
+
+int Projection::copy(const int node)
+{
+    nodes_.push_back(nodes_[node]);
+    const auto result = static_cast<int>(nodes_.size()) - 1;
+    for (auto member = std::size_t{0}; member < nodes_[result].members.size(); ++member)
+    {
+        const auto child = copy(nodes_[result].members[member].second);
+        nodes_[result].members[member].second = child;
+    }
+    if (nodes_[result].wildcard >= 0)
+    {
+        const auto child = copy(nodes_[result].wildcard);
+        nodes_[result].wildcard = child;
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dansandu::jelly::projection
+{
+
+// Set of JSON Pointers (RFC 6901) that select the parts of a document to deserialize. A token made of a single * is a
+// wildcard that matches every member of an object or element of a list. Paths are compiled once into a tree that is
+// walked while parsing, so the same projection can be used for any number of documents.
+class PRALINE_EXPORT Projection
+{
+public:
+    Projection(std::initializer_list<std::string_view> paths) : Projection{paths.begin(), paths.end()}
+    {
+    }
+
+    template<typename Iterator>
+    Projection(Iterator begin, Iterator end) : nodes_(1)
+    {
+        for (; begin != end; ++begin)
+        {
+            add(*begin);
+        }
+    }
+
+    static constexpr int root = 0;
+
+    // Returns the node of the member with the given key or -1 if the member is not selected.
+    int getMember(int node, std::string_view key) const;
+
+    // Returns the node of the list element with the given index or -1 if the element is not selected.
+    int getElement(int node, int index) const;
+
+    // Tells whether the value at the node is selected with everything it contains.
+    bool isWhole(int node) const
+    {
+        return nodes_[node].whole;
+    }
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<std::string, int>> members;
+        int wildcard = -1;
+        bool whole = false;
+    };
+
+    void add(std::string_view path);
+
+    void add(int node, const std::vector<std::string>& tokens, std::size_t position);
+
+    int copy(int node);
+
+    std::vector<Node> nodes_;
+};
+
+}
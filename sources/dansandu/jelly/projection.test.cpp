@@ -0,0 +1,69 @@
+#include "dansandu/jelly/projection.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dansandu::jelly::projection::Projection;
+
+TEST_CASE("Projection")
+{
+    SECTION("paths")
+    {
+        const auto projection = Projection{"/orderId", "/items/*/count", "/items/1/price", "/a~1b"};
+        const auto root = Projection::root;
+
+        REQUIRE(!projection.isWhole(root));
+
+        REQUIRE(projection.isWhole(projection.getMember(root, "orderId")));
+
+        REQUIRE(projection.isWhole(projection.getMember(root, "a/b")));
+
+        REQUIRE(projection.getMember(root, "vat") < 0);
+
+        const auto items = projection.getMember(root, "items");
+
+        REQUIRE(!projection.isWhole(items));
+
+        const auto first = projection.getElement(items, 0);
+        const auto second = projection.getElement(items, 1);
+
+        REQUIRE(projection.isWhole(projection.getMember(first, "count")));
+
+        REQUIRE(projection.getMember(first, "price") < 0);
+
+        REQUIRE(projection.isWhole(projection.getMember(second, "count")));
+
+        REQUIRE(projection.isWhole(projection.getMember(second, "price")));
+    }
+
+    SECTION("wildcard added after a named member")
+    {
+        const auto projection = Projection{"/a/b", "/*/c"};
+        const auto a = projection.getMember(Projection::root, "a");
+
+        REQUIRE(projection.isWhole(projection.getMember(a, "b")));
+
+        REQUIRE(projection.isWhole(projection.getMember(a, "c")));
+
+        REQUIRE(projection.getMember(projection.getMember(Projection::root, "z"), "b") < 0);
+    }
+
+    SECTION("whole values")
+    {
+        const auto paths = std::vector<std::string>{"/a/b/c", "/a"};
+        const auto projection = Projection{paths.cbegin(), paths.cend()};
+
+        REQUIRE(projection.isWhole(projection.getMember(Projection::root, "a")));
+
+        const auto everything = Projection{""};
+
+        REQUIRE(everything.isWhole(Projection::root));
+    }
+
+    SECTION("invalid path")
+    {
+        REQUIRE_THROWS_AS(Projection{"items"}, std::invalid_argument);
+    }
+}
@@ -0,0 +1,17 @@
+#include "dansandu/jelly/sax.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <string_view>
+
+using dansandu::jelly::options::DeserializationOptions;
+
+namespace dansandu::jelly::sax
+{
+
+void parse(std::string_view json, Handler& handler, const DeserializationOptions& options)
+{
+    dansandu::jelly::internal::parser::parse(json, handler, options);
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "dansandu/jelly/options.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace dansandu::jelly::sax
+{
+
+// Receives the values of a JSON document in the order they appear in the input. Strings and keys are only valid for
+// the duration of the call. Every event is a no-op by default so handlers only override the events they care about.
+class PRALINE_EXPORT Handler
+{
+public:
+    virtual ~Handler() = default;
+
+    virtual void onNull()
+    {
+    }
+
+    virtual void onBool(bool)
+    {
+    }
+
+    virtual void onInt(std::int64_t)
+    {
+    }
+
+    // Only called for integers above the range of std::int64_t.
+    virtual void onUint(std::uint64_t)
+    {
+    }
+
+    virtual void onDouble(double)
+    {
+    }
+
+    virtual void onString(std::string_view)
+    {
+    }
+
+    virtual void onKey(std::string_view)
+    {
+    }
+
+    virtual void onStartObject()
+    {
+    }
+
+    virtual void onEndObject()
+    {
+    }
+
+    virtual void onStartArray()
+    {
+    }
+
+    virtual void onEndArray()
+    {
+    }
+};
+
+PRALINE_EXPORT void parse(std::string_view json, Handler& handler,
+                          const dansandu::jelly::options::DeserializationOptions& options = {});
+
+}
@@ -0,0 +1,79 @@
+#include "dansandu/jelly/sax.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::options::DeserializationOptions;
+using dansandu::jelly::sax::Handler;
+using dansandu::jelly::sax::parse;
+
+class CountExtractor : public Handler
+{
+public:
+    void onInt(std::int64_t value) override
+    {
+        if (isCount_)
+        {
+            counts.push_back(value);
+        }
+        isCount_ = false;
+    }
+
+    void onKey(std::string_view key) override
+    {
+        isCount_ = key == "count";
+    }
+
+    void onStartObject() override
+    {
+        ++objects;
+    }
+
+    std::vector<std::int64_t> counts;
+    int objects = 0;
+
+private:
+    bool isCount_ = false;
+};
+
+TEST_CASE("Sax")
+{
+    SECTION("extract values")
+    {
+        auto extractor = CountExtractor{};
+
+        parse(R"({"orderId": "471fc736", "items": [{"itemId": "e01d9d5d", "count": 5},)"
+              R"({"itemId": "52cace0f", "count": 2, "price": 10}], "vat": 0.20, "previousOrderId": null})",
+              extractor);
+
+        REQUIRE(extractor.counts == std::vector<std::int64_t>{5, 2});
+
+        REQUIRE(extractor.objects == 3);
+    }
+
+    SECTION("default handler")
+    {
+        auto handler = Handler{};
+
+        REQUIRE_NOTHROW(parse(R"([null, true, 1, 2.0, "three", {"four": []}])", handler));
+
+        REQUIRE_THROWS_AS(parse(R"([null, true)", handler), JsonDeserializationError);
+    }
+
+    SECTION("input larger than the maximum size")
+    {
+        auto options = DeserializationOptions{};
+        options.maximumSize = 13;
+        auto extractor = CountExtractor{};
+
+        REQUIRE_THROWS_AS(parse(R"([{"count": 1}])", extractor, options), JsonDeserializationError);
+
+        REQUIRE(extractor.counts.empty());
+    }
+}
@@ -0,0 +1,57 @@
+#include "dansandu/jelly/sink.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace dansandu::jelly::sink
+{
+
+void StreamSink::write(std::string_view data)
+{
+    stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void FileSink::write(std::string_view data)
+{
+    if (std::fwrite(data.data(), 1, data.size(), file_) != data.size())
+    {
+        THROW(std::runtime_error, "could not write ", data.size(), " bytes to file");
+    }
+}
+
+void DescriptorSink::write(std::string_view data)
+{
+    while (!data.empty())
+    {
+#ifdef _WIN32
+        const auto written = ::_write(descriptor_, data.data(), static_cast<unsigned>(data.size()));
+#else
+        const auto written = ::write(descriptor_, data.data(), data.size());
+#endif
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written < 0)
+        {
+            THROW(std::runtime_error, "could not write ", data.size(), " bytes to file descriptor ", descriptor_);
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void CallbackSink::write(std::string_view data)
+{
+    callback_(data);
+}
+
+}
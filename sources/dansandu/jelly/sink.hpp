@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string_view>
+
+namespace dansandu::jelly::sink
+{
+
+class PRALINE_EXPORT Sink
+{
+public:
+    virtual ~Sink() = default;
+
+    virtual void write(std::string_view data) = 0;
+};
+
+class PRALINE_EXPORT StreamSink : public Sink
+{
+public:
+    explicit StreamSink(std::ostream& stream) : stream_{stream}
+    {
+    }
+
+    void write(std::string_view data) override;
+
+private:
+    std::ostream& stream_;
+};
+
+class PRALINE_EXPORT FileSink : public Sink
+{
+public:
+    explicit FileSink(std::FILE* file) : file_{file}
+    {
+    }
+
+    void write(std::string_view data) override;
+
+private:
+    std::FILE* file_;
+};
+
+class PRALINE_EXPORT DescriptorSink : public Sink
+{
+public:
+    explicit DescriptorSink(int descriptor) : descriptor_{descriptor}
+    {
+    }
+
+    void write(std::string_view data) override;
+
+private:
+    int descriptor_;
+};
+
+class PRALINE_EXPORT CallbackSink : public Sink
+{
+public:
+    explicit CallbackSink(std::function<void(std::string_view)> callback) : callback_{std::move(callback)}
+    {
+    }
+
+    void write(std::string_view data) override;
+
+private:
+    std::function<void(std::string_view)> callback_;
+};
+
+}
@@ -0,0 +1,81 @@
+#include "dansandu/jelly/sink.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#define fileno _fileno
+#endif
+
+using dansandu::jelly::sink::CallbackSink;
+using dansandu::jelly::sink::DescriptorSink;
+using dansandu::jelly::sink::FileSink;
+using dansandu::jelly::sink::StreamSink;
+
+static std::string readAll(std::FILE* file)
+{
+    std::rewind(file);
+    auto content = std::string{};
+    auto buffer = std::string(256, '\0');
+    while (const auto count = std::fread(buffer.data(), 1, buffer.size(), file))
+    {
+        content.append(buffer.data(), count);
+    }
+    return content;
+}
+
+TEST_CASE("Sink")
+{
+    SECTION("stream")
+    {
+        auto stream = std::stringstream{};
+        auto sink = StreamSink{stream};
+
+        sink.write("[1,");
+        sink.write("2]");
+
+        REQUIRE(stream.str() == "[1,2]");
+    }
+
+    SECTION("file")
+    {
+        const auto file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        auto sink = FileSink{file};
+
+        sink.write("{\"a\":");
+        sink.write("null}");
+        std::fflush(file);
+
+        REQUIRE(readAll(file) == "{\"a\":null}");
+
+        std::fclose(file);
+    }
+
+    SECTION("descriptor")
+    {
+        const auto file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        auto sink = DescriptorSink{fileno(file)};
+
+        sink.write("true");
+
+        REQUIRE(readAll(file) == "true");
+
+        std::fclose(file);
+    }
+
+    SECTION("callback")
+    {
+        auto chunks = std::string{};
+        auto sink = CallbackSink{[&](std::string_view chunk) { chunks.append(chunk).append("|"); }};
+
+        sink.write("[]");
+        sink.write("{}");
+
+        REQUIRE(chunks == "[]|{}|");
+    }
+}
@@ -0,0 +1,269 @@
+#include "dansandu/jelly/view.hpp"
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/jelly/error.hpp"
+#include "dansandu/jelly/internal/parser.hpp"
+#include "dansandu/jelly/internal/tokenizer.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::internal::parser::Parser;
+using dansandu::jelly::internal::tokenizer::checkInputSize;
+using dansandu::jelly::options::DeserializationOptions;
+
+namespace dansandu::jelly::view
+{
+
+class Document::Builder
+{
+public:
+    // The root of the parsed value is stored in the given node instead of a new one when the node is not negative.
+    Builder(const Document& document, std::string_view json, int root = -1)
+        : document_{document}, json_{json}, root_{root}
+    {
+    }
+
+    void onNull()
+    {
+        add(nullptr);
+    }
+
+    void onBool(bool value)
+    {
+        add(value);
+    }
+
+    void onInt(std::int64_t value)
+    {
+        if (std::numeric_limits<int>::min() <= value && value <= std::numeric_limits<int>::max())
+        {
+            add(static_cast<int>(value));
+        }
+        else
+        {
+            add(value);
+        }
+    }
+
+    void onUint(std::uint64_t value)
+    {
+        add(value);
+    }
+
+    void onDouble(double value)
+    {
+        add(value);
+    }
+
+    void onString(std::string_view value)
+    {
+        add(keep(value));
+    }
+
+    void onKey(std::string_view key)
+    {
+        key_ = keep(key);
+    }
+
+    // Only the containers nested in the value being parsed are skipped, which leaves them for later.
+    bool skips() const
+    {
+        return !containers_.empty();
+    }
+
+    void onSkipped(int begin, int end)
+    {
+        add(Unparsed{begin, end});
+    }
+
+    void onStartObject()
+    {
+        containers_.push_back({add(Members{}), static_cast<int>(members_.size())});
+    }
+
+    void onEndObject()
+    {
+        const auto [node, mark] = containers_.back();
+        containers_.pop_back();
+
+        const auto begin = members_.begin() + mark;
+        std::sort(begin, members_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        const auto duplicate =
+            std::adjacent_find(begin, members_.end(), [](const auto& a, const auto& b) { return a.first == b.first; });
+        if (duplicate != members_.end())
+        {
+            THROW(JsonDeserializationError, "duplicate key '", duplicate->first, "' found in Json object");
+        }
+
+        const auto size = static_cast<int>(members_.size()) - mark;
+        document_.nodes_[node] = Members{static_cast<int>(document_.members_.size()), size};
+        document_.members_.insert(document_.members_.end(), begin, members_.end());
+        members_.erase(begin, members_.end());
+    }
+
+    void onStartArray()
+    {
+        containers_.push_back({add(Elements{}), static_cast<int>(elements_.size())});
+    }
+
+    void onEndArray()
+    {
+        const auto [node, mark] = containers_.back();
+        containers_.pop_back();
+
+        const auto begin = elements_.begin() + mark;
+        const auto size = static_cast<int>(elements_.size()) - mark;
+        document_.nodes_[node] = Elements{static_cast<int>(document_.elements_.size()), size};
+        document_.elements_.insert(document_.elements_.end(), begin, elements_.end());
+        elements_.erase(begin, elements_.end());
+    }
+
+private:
+    // Children are collected here while their container is open and are moved to the document in one contiguous
+    // range once it closes, so the children of every container end up next to each other.
+    int add(Document::value_type value)
+    {
+        if (containers_.empty() && root_ >= 0)
+        {
+            document_.nodes_[root_] = value;
+            return root_;
+        }
+
+        const auto node = static_cast<int>(document_.nodes_.size());
+        document_.nodes_.push_back(value);
+        if (!containers_.empty())
+        {
+            if (std::holds_alternative<Elements>(document_.nodes_[containers_.back().first]))
+            {
+                elements_.push_back(node);
+            }
+            else
+            {
+                members_.emplace_back(key_, node);
+            }
+        }
+        return node;
+    }
+
+    // Strings with escape sequences are decoded by the parser into a buffer it reuses, so they are copied into the
+    // document. All other strings are views into the input.
+    std::string_view keep(std::string_view string)
+    {
+        if (json_.data() <= string.data() && string.data() <= json_.data() + json_.size())
+        {
+            return string;
+        }
+        return document_.decoded_.emplace_back(string);
+    }
+
+    const Document& document_;
+    std::string_view json_;
+    int root_;
+    std::string_view key_;
+    std::vector<std::pair<int, int>> containers_;
+    std::vector<int> elements_;
+    std::vector<std::pair<std::string_view, int>> members_;
+};
+
+Document Document::parse(std::string_view json, const DeserializationOptions& options)
+{
+    auto document = Document{};
+    auto builder = Builder{document, json};
+    dansandu::jelly::internal::parser::parse(json, builder, options);
+    return document;
+}
+
+Document Document::parseLazily(std::string_view json, const DeserializationOptions& options)
+{
+    auto document = Document{};
+    document.json_ = checkInputSize(json, options.maximumSize);
+    document.validateUtf8_ = options.validateUtf8;
+    document.nodes_.emplace_back(nullptr);
+    document.parseLevel(0, 0, static_cast<int>(json.size()));
+    return document;
+}
+
+void Document::parseLevel(const int node, const int begin, const int end) const
+{
+    // A container that fails to parse is put back the way it was, so accessing it again reports the same error.
+    const auto value = nodes_[node];
+    const auto nodes = nodes_.size();
+    const auto elements = elements_.size();
+    const auto members = members_.size();
+    const auto decoded = decoded_.size();
+    try
+    {
+        auto builder = Builder{*this, json_, node};
+        auto parser = Parser{};
+        parser.parseSkipping(json_.substr(0, end), builder, validateUtf8_, begin);
+    }
+    catch (...)
+    {
+        nodes_[node] = value;
+        nodes_.resize(nodes);
+        elements_.resize(elements);
+        members_.resize(members);
+        decoded_.resize(decoded);
+        throw;
+    }
+}
+
+int JsonView::size() const
+{
+    document_->expand(node_);
+    const auto& value = document_->nodes_[node_];
+    if (const auto elements = std::get_if<Document::Elements>(&value))
+    {
+        return elements->size;
+    }
+    if (const auto members = std::get_if<Document::Members>(&value))
+    {
+        return members->size;
+    }
+    THROW(std::logic_error, "size requested for json view that is neither a list nor an object");
+}
+
+JsonView JsonView::operator[](const int index) const
+{
+    document_->expand(node_);
+    const auto elements = std::get_if<Document::Elements>(&document_->nodes_[node_]);
+    if (elements == nullptr)
+    {
+        THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+    }
+    if (index < 0 || index >= elements->size)
+    {
+        THROW(std::out_of_range, "index ", index, " is out of range for json list of size ", elements->size);
+    }
+    return JsonView{document_, document_->elements_[elements->begin + index]};
+}
+
+JsonView JsonView::operator[](const std::string_view key) const
+{
+    document_->expand(node_);
+    const auto members = std::get_if<Document::Members>(&document_->nodes_[node_]);
+    if (members == nullptr)
+    {
+        THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+    }
+    const auto begin = document_->members_.cbegin() + members->begin;
+    const auto end = begin + members->size;
+    const auto position =
+        std::lower_bound(begin, end, key, [](const auto& member, std::string_view k) { return member.first < k; });
+    if (position == end || position->first != key)
+    {
+        THROW(std::out_of_range, "key '", key, "' not found in json object");
+    }
+    return JsonView{document_, position->second};
+}
+
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/ballotin/type_traits.hpp"
+#include "dansandu/jelly/options.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dansandu::jelly::view
+{
+
+class Document;
+
+// Read-only handle to a value of a Document. Views are cheap to copy and stay valid for as long as the document and
+// the input it was parsed from are alive.
+class PRALINE_EXPORT JsonView
+{
+public:
+    using null_type = std::nullptr_t;
+    using string_type = std::string_view;
+
+    class list_type;
+
+    class object_type;
+
+private:
+    using held_types = dansandu::ballotin::type_traits::TypePack<null_type, bool, int, std::int64_t, std::uint64_t,
+                                                                 double, string_type, list_type, object_type>;
+    using safe_cast_types =
+        dansandu::ballotin::type_traits::TypePack<bool, int, std::int64_t, std::uint64_t, double, string_type>;
+
+public:
+    template<typename Type, typename = std::enable_if_t<held_types::contains<Type>>>
+    bool is() const;
+
+    // Lists and objects are returned as ranges of views over their elements and members.
+    template<typename Type, typename = std::enable_if_t<held_types::contains<Type>>>
+    Type get() const;
+
+    int size() const;
+
+    JsonView operator[](const int index) const;
+
+    JsonView operator[](const std::string_view key) const;
+
+    template<typename Type, typename DecayedType = std::decay_t<Type>,
+             typename = std::enable_if_t<safe_cast_types::contains<DecayedType>>>
+    operator Type() const
+    {
+        return get<DecayedType>();
+    }
+
+private:
+    friend class Document;
+
+    JsonView(const Document* document, int node) : document_{document}, node_{node}
+    {
+    }
+
+    static JsonView getElement(const Document* document, int position);
+
+    static std::pair<std::string_view, JsonView> getMember(const Document* document, int position);
+
+    const Document* document_;
+    int node_;
+};
+
+// The elements of a list view. Elements are read by position when iterated, so the range stays valid while lazy
+// containers are parsed.
+class JsonView::list_type
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = JsonView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = JsonView;
+
+        const_iterator() = default;
+
+        JsonView operator*() const
+        {
+            return getElement(document_, position_);
+        }
+
+        const_iterator& operator++()
+        {
+            ++position_;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++position_;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return position_ != other.position_;
+        }
+
+    private:
+        friend class list_type;
+
+        const_iterator(const Document* document, int position) : document_{document}, position_{position}
+        {
+        }
+
+        const Document* document_ = nullptr;
+        int position_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const
+    {
+        return const_iterator{document_, begin_};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{document_, begin_ + size_};
+    }
+
+    int size() const
+    {
+        return size_;
+    }
+
+private:
+    friend class JsonView;
+
+    list_type(const Document* document, int begin, int size) : document_{document}, begin_{begin}, size_{size}
+    {
+    }
+
+    const Document* document_;
+    int begin_;
+    int size_;
+};
+
+// The members of an object view as pairs of key and value, in the order of their keys.
+class JsonView::object_type
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<std::string_view, JsonView>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() = default;
+
+        value_type operator*() const
+        {
+            return getMember(document_, position_);
+        }
+
+        const_iterator& operator++()
+        {
+            ++position_;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++position_;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return position_ != other.position_;
+        }
+
+    private:
+        friend class object_type;
+
+        const_iterator(const Document* document, int position) : document_{document}, position_{position}
+        {
+        }
+
+        const Document* document_ = nullptr;
+        int position_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const
+    {
+        return const_iterator{document_, begin_};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{document_, begin_ + size_};
+    }
+
+    int size() const
+    {
+        return size_;
+    }
+
+private:
+    friend class JsonView;
+
+    object_type(const Document* document, int begin, int size) : document_{document}, begin_{begin}, size_{size}
+    {
+    }
+
+    const Document* document_;
+    int begin_;
+    int size_;
+};
+
+// Parsed JSON document that stores its values in flat arrays and refers to strings and keys in the input instead of
+// copying them. Only strings with escape sequences are decoded into storage owned by the document. The input must
+// outlive the document.
+class PRALINE_EXPORT Document
+{
+public:
+    static Document parse(std::string_view json,
+                          const dansandu::jelly::options::DeserializationOptions& options = {});
+
+    // Parses only the top level of the document. Nested lists and objects are skipped by matching their brackets and
+    // are parsed one level at a time when they are first accessed, so the cost follows the values that are used.
+    // Errors inside a container, including duplicate keys, are only reported once it is accessed. Accessing a lazy
+    // document from several threads at once is not safe.
+    static Document parseLazily(std::string_view json,
+                                const dansandu::jelly::options::DeserializationOptions& options = {});
+
+    Document() = default;
+
+    // Decoded strings are referred to by the nodes of the document that owns them, so documents can only be moved.
+    Document(const Document&) = delete;
+
+    Document(Document&&) = default;
+
+    Document& operator=(const Document&) = delete;
+
+    Document& operator=(Document&&) = default;
+
+    JsonView getRoot() const
+    {
+        return JsonView{this, 0};
+    }
+
+    JsonView operator[](const int index) const
+    {
+        return getRoot()[index];
+    }
+
+    JsonView operator[](const std::string_view key) const
+    {
+        return getRoot()[key];
+    }
+
+private:
+    friend class JsonView;
+
+    class Builder;
+
+    struct Elements
+    {
+        int begin;
+        int size;
+    };
+
+    struct Members
+    {
+        int begin;
+        int size;
+    };
+
+    // Position of a list or object in the input that has not been parsed yet.
+    struct Unparsed
+    {
+        int begin;
+        int end;
+    };
+
+    using value_type = std::variant<std::nullptr_t, bool, int, std::int64_t, std::uint64_t, double, std::string_view,
+                                    Elements, Members, Unparsed>;
+
+    // Parses the value found between begin and end in the input into the node, skipping the containers nested in it.
+    void parseLevel(int node, int begin, int end) const;
+
+    // Parses the node if it is a container that was skipped.
+    void expand(int node) const
+    {
+        if (const auto unparsed = std::get_if<Unparsed>(&nodes_[node]))
+        {
+            parseLevel(node, unparsed->begin, unparsed->end);
+        }
+    }
+
+    // Lazy documents grow when their containers are first accessed, which does not change the values they hold.
+    mutable std::vector<value_type> nodes_;
+    mutable std::vector<int> elements_;
+    mutable std::vector<std::pair<std::string_view, int>> members_;
+    mutable std::deque<std::string> decoded_;
+    std::string_view json_;
+    bool validateUtf8_ = false;
+};
+
+template<typename Type, typename>
+bool JsonView::is() const
+{
+    const auto& value = document_->nodes_[node_];
+    if constexpr (std::is_same_v<Type, list_type>)
+    {
+        const auto unparsed = std::get_if<Document::Unparsed>(&value);
+        return std::holds_alternative<Document::Elements>(value) ||
+               (unparsed && document_->json_[unparsed->begin] == '[');
+    }
+    else if constexpr (std::is_same_v<Type, object_type>)
+    {
+        const auto unparsed = std::get_if<Document::Unparsed>(&value);
+        return std::holds_alternative<Document::Members>(value) ||
+               (unparsed && document_->json_[unparsed->begin] == '{');
+    }
+    else
+    {
+        return std::holds_alternative<Type>(value);
+    }
+}
+
+template<typename Type, typename>
+Type JsonView::get() const
+{
+    if constexpr (std::is_same_v<Type, list_type>)
+    {
+        document_->expand(node_);
+        if (const auto elements = std::get_if<Document::Elements>(&document_->nodes_[node_]))
+        {
+            return list_type{document_, elements->begin, elements->size};
+        }
+    }
+    else if constexpr (std::is_same_v<Type, object_type>)
+    {
+        document_->expand(node_);
+        if (const auto members = std::get_if<Document::Members>(&document_->nodes_[node_]))
+        {
+            return object_type{document_, members->begin, members->size};
+        }
+    }
+    else if (const auto value = std::get_if<Type>(&document_->nodes_[node_]))
+    {
+        return *value;
+    }
+    THROW(std::logic_error, "invalid type requested in json getter -- json holds a different type");
+}
+
+inline JsonView JsonView::getElement(const Document* document, int position)
+{
+    return JsonView{document, document->elements_[position]};
+}
+
+inline std::pair<std::string_view, JsonView> JsonView::getMember(const Document* document, int position)
+{
+    const auto& member = document->members_[position];
+    return {member.first, JsonView{document, member.second}};
+}
+
+}
@@ -0,0 +1,216 @@
+#include "dansandu/jelly/view.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/jelly/error.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using dansandu::jelly::error::JsonDeserializationError;
+using dansandu::jelly::view::Document;
+using dansandu::jelly::view::JsonView;
+
+static_assert(!std::is_copy_constructible_v<Document> && !std::is_copy_assignable_v<Document>);
+
+TEST_CASE("JsonView")
+{
+    SECTION("primitive")
+    {
+        const auto document = Document::parse("0.125");
+
+        REQUIRE(document.getRoot().is<double>());
+
+        REQUIRE(document.getRoot().get<double>() == 0.125);
+
+        REQUIRE_THROWS_AS(document.getRoot().get<int>(), std::logic_error);
+    }
+
+    SECTION("strings refer to the input")
+    {
+        const auto string = std::string{R"({"key":"value"})"};
+
+        const auto document = Document::parse(string);
+
+        const auto value = document["key"].get<JsonView::string_type>();
+
+        REQUIRE(value == "value");
+
+        REQUIRE(value.data() == string.data() + 8);
+    }
+
+    SECTION("escaped strings are decoded")
+    {
+        const auto document = Document::parse(R"({"a\tb":["x\"y","\u00e9"]})");
+
+        REQUIRE(document["a\tb"][0].get<JsonView::string_type>() == "x\"y");
+
+        REQUIRE(document["a\tb"][1].get<JsonView::string_type>() == "\xc3\xa9");
+    }
+
+    SECTION("moved documents keep their decoded strings")
+    {
+        auto original = Document::parse(R"(["x\"y"])");
+        auto moved = std::move(original);
+        original = Document::parse("[]");
+
+        REQUIRE(moved[0].get<JsonView::string_type>() == "x\"y");
+    }
+
+    SECTION("big json")
+    {
+        const auto string = R"([{"battery":88,"identifier":"f2c4deb09cc1558","lastCharge":1597779221,"list":[],)"
+                            R"("location":[50,10],"samples":{"CO":2,"O2":19},"timestamp":1597780427},)"
+                            R"({"battery":41,"identifier":"1eb6731c7132367","lastCharge":null,"location":[26,32],)"
+                            R"("map":{},"samples":{"CO":18,"O2":10},"timestamp":1597780001}])";
+
+        const auto document = Document::parse(string);
+
+        REQUIRE(document.getRoot().is<JsonView::list_type>());
+
+        REQUIRE(document.getRoot().size() == 2);
+
+        REQUIRE(document[0].is<JsonView::object_type>());
+
+        REQUIRE(document[0].size() == 7);
+
+        REQUIRE(document[0]["identifier"].get<JsonView::string_type>() == "f2c4deb09cc1558");
+
+        REQUIRE(document[0]["list"].size() == 0);
+
+        REQUIRE(document[0]["location"][1].get<int>() == 10);
+
+        REQUIRE(document[0]["samples"]["O2"].get<int>() == 19);
+
+        REQUIRE(document[1]["lastCharge"].is<JsonView::null_type>());
+
+        REQUIRE(document[1]["map"].size() == 0);
+
+        const int timestamp = document[1]["timestamp"];
+
+        REQUIRE(timestamp == 1597780001);
+
+        REQUIRE_THROWS_AS(document[2], std::logic_error);
+
+        REQUIRE_THROWS_AS(document[0]["missing"], std::logic_error);
+
+        REQUIRE_THROWS_AS(document[0]["battery"][0], std::logic_error);
+    }
+
+    SECTION("lazy")
+    {
+        const auto string = R"({"id":"f2c4deb09cc1558","envelope":{"headers":{"a":"}]\"{["},"body":[[1,2],{"b":[]}]},)"
+                            R"("items":[{"count":5},{"count":2}],"empty":[],"last":true})";
+
+        const auto document = Document::parseLazily(string);
+
+        REQUIRE(document["id"].get<JsonView::string_type>() == "f2c4deb09cc1558");
+
+        REQUIRE(document["last"].get<bool>());
+
+        REQUIRE(document["envelope"].is<JsonView::object_type>());
+
+        REQUIRE(!document["envelope"].is<JsonView::list_type>());
+
+        REQUIRE(document["items"].is<JsonView::list_type>());
+
+        REQUIRE(document["items"].size() == 2);
+
+        REQUIRE(document["items"][1]["count"].get<int>() == 2);
+
+        REQUIRE(document["envelope"]["headers"]["a"].get<JsonView::string_type>() == "}]\"{[");
+
+        REQUIRE(document["envelope"]["body"][0][1].get<int>() == 2);
+
+        REQUIRE(document["envelope"]["body"][1]["b"].size() == 0);
+
+        REQUIRE(document["empty"].size() == 0);
+
+        REQUIRE(Document::parseLazily(" -7 ").getRoot().get<int>() == -7);
+    }
+
+    SECTION("iterate")
+    {
+        const auto string = R"({"b":[1,"two",[3]],"a":{"y":true,"x":null},"c":[]})";
+
+        for (const auto& document : {Document::parse(string), Document::parseLazily(string)})
+        {
+            const auto list = document["b"].get<JsonView::list_type>();
+            auto element = list.begin();
+
+            REQUIRE((*element).get<int>() == 1);
+
+            REQUIRE((*++element).get<JsonView::string_type>() == "two");
+
+            REQUIRE((*++element)[0].get<int>() == 3);
+
+            REQUIRE(++element == list.end());
+
+            auto size = 0;
+            for (const auto value : list)
+            {
+                size += value.is<JsonView::list_type>() ? value.size() : 1;
+            }
+
+            REQUIRE(size == 3);
+
+            auto keys = std::vector<std::string_view>{};
+            for (const auto& [key, value] : document.getRoot().get<JsonView::object_type>())
+            {
+                keys.push_back(key);
+                if (key == "a")
+                {
+                    REQUIRE(value.get<JsonView::object_type>().size() == 2);
+
+                    REQUIRE((*value.get<JsonView::object_type>().begin()).first == "x");
+
+                    REQUIRE((*value.get<JsonView::object_type>().begin()).second.is<JsonView::null_type>());
+                }
+            }
+
+            REQUIRE(keys == std::vector<std::string_view>{"a", "b", "c"});
+
+            const auto empty = document["c"].get<JsonView::list_type>();
+
+            REQUIRE(empty.begin() == empty.end());
+
+            REQUIRE_THROWS_AS(document["a"].get<JsonView::list_type>(), std::logic_error);
+
+            REQUIRE_THROWS_AS(document["b"].get<JsonView::object_type>(), std::logic_error);
+        }
+    }
+
+    SECTION("lazy bad json")
+    {
+        REQUIRE_THROWS_AS(Document::parseLazily(R"({"a": [1, 2})"), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Document::parseLazily(R"({"a": 1} 2)"), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Document::parseLazily(R"({"a" [1]})"), JsonDeserializationError);
+
+        const auto document = Document::parseLazily(R"({"a": [1 2], "b": {"c": 1, "c": 2}, "d": [1, ], "e": 1})");
+
+        REQUIRE(document["e"].get<int>() == 1);
+
+        REQUIRE_THROWS_AS(document["a"][0], JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(document["b"]["c"], JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(document["d"].size(), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Document::parseLazily(R"({"y":[1,2},"x":1})"), JsonDeserializationError);
+
+        REQUIRE_THROWS_WITH(document["a"].size(), Catch::Contains("at position 10"));
+
+        REQUIRE(document["a"].is<JsonView::list_type>());
+    }
+
+    SECTION("bad json")
+    {
+        REQUIRE_THROWS_AS(Document::parse(R"({"a": [1, 2})"), JsonDeserializationError);
+
+        REQUIRE_THROWS_AS(Document::parse(R"({"a": 1, "b": 2, "a": 3})"), JsonDeserializationError);
+    }
+}